@@ -5,434 +5,4441 @@
 module_description: Shared debug shell utilities
 constructor_args: []
 template_args: []
-required_hardware: []
+required_hardware: [ramfs]
 depends: []
 === END MANIFEST === */
 // clang-format on
 
 #include <array>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstdio>
 #include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
 
+#include "DebugCoreBinary.hpp"
+#include "DebugCoreFormat.hpp"
+#include "DebugCoreNames.hpp"
+#include "DebugCoreView.hpp"
 #include "app_framework.hpp"
 #include "libxr_def.hpp"
 #include "libxr_rw.hpp"
+#include "mutex.hpp"
+#include "ramfs.hpp"
+#include "semaphore.hpp"
 #include "thread.hpp"
-
-namespace debug_core {
+#include "timebase.hpp"
 
 /**
- * @brief 视图名称与视图值映射项
- * @tparam View 视图值类型
+ * @brief 是否编译调试实现，0 时字段宏、提供器与命令执行器退化为空的 constexpr
+ *        桩，镜像中不含字段表、字段名与命令实现
  */
-template <typename View>
-struct ViewEntry {
-  const char* name;
-  View view;
-};
+#ifndef DEBUG_CORE_ENABLED
+#define DEBUG_CORE_ENABLED 1
+#endif
 
 /**
- * @brief 按视图表解析视图名
- * @tparam View 视图值类型
- * @tparam N 视图表大小
- * @param arg 视图字符串
- * @param table 视图映射表
- * @param out 输出视图值
- * @return bool 解析成功返回 true
+ * @brief 单帧暂存缓冲区大小（字节）
  */
-template <typename View, size_t N>
-bool parse_view_table(const char* arg,
-                      const std::array<ViewEntry<View>, N>& table, View* out) {
-  if (arg == nullptr || out == nullptr) {
-    return false;
-  }
-  for (const auto& item : table) {
-    if (std::strcmp(arg, item.name) == 0) {
-      *out = item.view;
-      return true;
-    }
-  }
-  return false;
-}
+#ifndef DEBUG_CORE_FRAME_BUFFER_SIZE
+#define DEBUG_CORE_FRAME_BUFFER_SIZE 512
+#endif
 
 /**
- * @brief 解析 uint8_t 视图名
- * @tparam N 视图表大小
- * @param arg 视图字符串
- * @param table 视图映射表
- * @param out 输出视图值
- * @return bool 解析成功返回 true
+ * @brief 暂存缓冲区溢出策略：1 分块输出，0 截断
  */
-template <size_t N>
-bool parse_view_name(const char* arg,
-                     const std::array<ViewEntry<uint8_t>, N>& table,
-                     uint8_t* out) {
-  return parse_view_table(arg, table, out);
-}
+#ifndef DEBUG_CORE_FRAME_OVERFLOW_CHUNK
+#define DEBUG_CORE_FRAME_OVERFLOW_CHUNK 1
+#endif
 
 /**
- * @brief 根据视图值获取视图名
- * @tparam N 视图表大小
- * @param view 视图值
- * @param table 视图映射表
- * @param fallback 未找到时返回值
- * @return const char* 视图名字符串
+ * @brief 后台 monitor 任务槽数量
  */
-template <size_t N>
-const char* view_name(uint8_t view,
-                      const std::array<ViewEntry<uint8_t>, N>& table,
-                      const char* fallback = "unknown") {
-  for (const auto& item : table) {
-    if (item.view == view) {
-      return item.name;
-    }
-  }
-  return fallback;
-}
+#ifndef DEBUG_CORE_MAX_JOBS
+#define DEBUG_CORE_MAX_JOBS 4
+#endif
 
 /**
- * @brief 成员函数命令桥接
- * @tparam Owner 模块类型
- * @tparam MemberFunc 成员命令函数
- * @param self 模块实例
- * @param argc 参数数量
- * @param argv 参数数组
- * @return int 命令返回值
+ * @brief 后台 monitor 工作线程栈大小
  */
-template <typename Owner, int (Owner::*MemberFunc)(int, char**)>
-int command_thunk(Owner* self, int argc, char** argv) {
-  return (self->*MemberFunc)(argc, argv);
-}
+#ifndef DEBUG_CORE_JOB_STACK_SIZE
+#define DEBUG_CORE_JOB_STACK_SIZE 4096
+#endif
 
 /**
- * @brief 通用命令解析执行器
- * @tparam View 视图类型
- * @tparam ParseViewFn 视图解析回调类型
- * @tparam PrintOnceFn 单次打印回调类型
- * @tparam PrintUsageFn 帮助打印回调类型
- * @return int 命令返回值
+ * @brief 后台 monitor 工作线程优先级
  */
-template <typename View, typename ParseViewFn, typename PrintOnceFn,
-          typename PrintUsageFn>
-int run_command(int argc, char** argv, View default_view,
-                ParseViewFn parse_view, PrintOnceFn print_once,
-                PrintUsageFn print_usage) {
-  if (argc <= 1) {
-    print_usage();
-    return 0;
-  }
-
-  if (std::strcmp(argv[1], "monitor") == 0) {
-    if (argc == 2) {
-      print_once(default_view);
-      return 0;
-    }
-
-    if (argc > 5) {
-      LibXR::STDIO::Printf<"Error: Too many arguments for monitor.\r\n">();
-      return -1;
-    }
-
-    int time_ms = std::atoi(argv[2]);
-    int interval_ms = 1000;
-    View view = default_view;
-    bool third_is_view = false;
-
-    if (argc >= 4) {
-      View parsed_view = default_view;
-      if (parse_view(argv[3], &parsed_view)) {
-        view = parsed_view;
-        third_is_view = true;
-      } else {
-        interval_ms = std::atoi(argv[3]);
-      }
-    }
-
-    if (argc == 5) {
-      if (third_is_view) {
-        LibXR::STDIO::Printf<"Error: Invalid monitor args. Use monitor <time_ms> [interval_ms] "
-            "[view].\r\n">();
-        return -1;
-      }
-      if (!parse_view(argv[4], &view)) {
-        LibXR::STDIO::Printf<"Error: Unknown view '%s'.\r\n">(argv[4]);
-        return -1;
-      }
-    }
-
-    if (time_ms <= 0 || interval_ms <= 0) {
-      LibXR::STDIO::Printf<"Error: time_ms and interval_ms must be > 0.\r\n">();
-      return -1;
-    }
-
-    int elapsed = 0;
-    while (elapsed < time_ms) {
-      print_once(view);
-      LibXR::Thread::Sleep(interval_ms);
-      elapsed += interval_ms;
-    }
-    return 0;
-  }
-
-  if (std::strcmp(argv[1], "once") == 0) {
-    if (argc > 3) {
-      LibXR::STDIO::Printf<"Error: Too many arguments for once.\r\n">();
-      return -1;
-    }
+#ifndef DEBUG_CORE_JOB_PRIORITY
+#define DEBUG_CORE_JOB_PRIORITY LibXR::Thread::Priority::LOW
+#endif
 
-    View view = default_view;
-    if (argc == 3 && !parse_view(argv[2], &view)) {
-      LibXR::STDIO::Printf<"Error: Unknown view '%s'.\r\n">(argv[2]);
-      return -1;
-    }
+/**
+ * @brief 单个后台任务可保存的打印回调大小（字节）
+ * @details 合并采样回调按提供器保存视图选择，视图掩码超过 32 位时随之增大。
+ */
+#ifndef DEBUG_CORE_JOB_CONTEXT_SIZE
+#define DEBUG_CORE_JOB_CONTEXT_SIZE \
+  (136 + DEBUG_CORE_MAX_PROVIDERS * ((DEBUG_CORE_MAX_VIEWS + 31) / 32 - 1) * 4)
+#endif
 
-    print_once(view);
-    return 0;
-  }
+/**
+ * @brief 后台任务等待下一帧时检查停止请求的最长间隔
+ */
+#ifndef DEBUG_CORE_JOB_STOP_POLL_MS
+#define DEBUG_CORE_JOB_STOP_POLL_MS 50
+#endif
 
-  View direct_view = default_view;
-  if (argc == 2 && parse_view(argv[1], &direct_view)) {
-    print_once(direct_view);
-    return 0;
-  }
+/**
+ * @brief Live 模式单帧采集缓冲区大小（字段值 + 自定义字段文本，字节）
+ */
+#ifndef DEBUG_CORE_LIVE_CAPTURE_SIZE
+#define DEBUG_CORE_LIVE_CAPTURE_SIZE 512
+#endif
 
-  LibXR::STDIO::Printf<"Error: Unknown command '%s'.\r\n">(argv[1]);
-  return -1;
-}
+/**
+ * @brief Live 模式单帧最多采集的字段数
+ */
+#ifndef DEBUG_CORE_LIVE_MAX_FIELDS
+#define DEBUG_CORE_LIVE_MAX_FIELDS 64
+#endif
 
-using ViewMask = uint32_t;
+/**
+ * @brief 全局注册表可容纳的提供器数量（不超过 32）
+ */
+#ifndef DEBUG_CORE_MAX_PROVIDERS
+#define DEBUG_CORE_MAX_PROVIDERS 8
+#endif
 
 /**
- * @brief 根据视图编号生成掩码位
- * @param view 视图编号
- * @return ViewMask 视图掩码
+ * @brief 合并采样时保存各模块快照 / Live 文本的暂存区大小（字节）
  */
-constexpr ViewMask view_bit(uint8_t view) { return 1u << view; }
+#ifndef DEBUG_CORE_SAMPLER_ARENA_SIZE
+#define DEBUG_CORE_SAMPLER_ARENA_SIZE 1024
+#endif
 
 /**
- * @brief Structured 模式字段描述
+ * @brief stats 模式可统计的最大字段数
  */
-struct FieldDesc {
-  const char* name;
-  size_t offset;
-  ViewMask view_mask;
-  void (*print)(const char* name, const void* field_ptr);
-};
+#ifndef DEBUG_CORE_STATS_MAX_FIELDS
+#define DEBUG_CORE_STATS_MAX_FIELDS 16
+#endif
 
 /**
- * @brief Structured 模式提供器
- * @tparam Snapshot 快照类型
+ * @brief delta 模式可缓存的最大字段数，超出的字段每帧都输出
  */
-template <typename Snapshot>
-struct StructuredProvider {
-  const char* module_name;
-  const char* view_help;
-  bool (*parse_view)(const char* arg, uint8_t* out_view);
-  const char* (*view_to_string)(uint8_t view);
-  void (*capture)(void* self, Snapshot* out_snapshot);
-  const FieldDesc* fields;
-  size_t field_count;
-};
+#ifndef DEBUG_CORE_DELTA_MAX_FIELDS
+#define DEBUG_CORE_DELTA_MAX_FIELDS 32
+#endif
 
 /**
- * @brief 打印布尔字段值
+ * @brief delta 模式默认关键帧间隔（帧）
  */
-inline void print_bool_field(const char* name, const void* field_ptr) {
-  bool value = *reinterpret_cast<const bool*>(field_ptr);
-  LibXR::STDIO::Printf<"  %s=%s\r\n">(name, value ? "true" : "false");
-}
+#ifndef DEBUG_CORE_DELTA_KEYFRAME_INTERVAL
+#define DEBUG_CORE_DELTA_KEYFRAME_INTERVAL 20
+#endif
 
 /**
- * @brief 打印 uint8 字段值
+ * @brief 降采样模式可规约的最大字段数，超出的字段取最后值
  */
-inline void print_u8_field(const char* name, const void* field_ptr) {
-  uint8_t value = *reinterpret_cast<const uint8_t*>(field_ptr);
-  LibXR::STDIO::Printf<"  %s=%u\r\n">(name, static_cast<unsigned>(value));
-}
+#ifndef DEBUG_CORE_REDUCE_MAX_FIELDS
+#define DEBUG_CORE_REDUCE_MAX_FIELDS 16
+#endif
 
 /**
- * @brief 打印 float 字段值
+ * @brief prof 模式使用的微秒时钟，返回 uint32_t
+ * @details 默认取 libxr 时基；平台提供更轻量的周期计数器时可覆盖。
  */
-inline void print_f32_field(const char* name, const void* field_ptr) {
-  float value = *reinterpret_cast<const float*>(field_ptr);
-  LibXR::STDIO::Printf<"  %s=%.4f\r\n">(name, value);
-}
+#ifndef DEBUG_CORE_PROFILE_CLOCK_US
+#define DEBUG_CORE_PROFILE_CLOCK_US() \
+  static_cast<uint32_t>(               \
+      static_cast<uint64_t>(LibXR::Timebase::GetMicroseconds()))
+#endif
+
+namespace debug_core {
 
 /**
- * @brief 打印布尔值
+ * @brief 成员函数命令桥接
+ * @tparam Owner 模块类型
+ * @tparam MemberFunc 成员命令函数
+ * @param self 模块实例
+ * @param argc 参数数量
+ * @param argv 参数数组
+ * @return int 命令返回值
  */
-inline void print_bool_value(const char* name, bool value) {
-  LibXR::STDIO::Printf<"  %s=%s\r\n">(name, value ? "true" : "false");
+template <typename Owner, int (Owner::*MemberFunc)(int, char**)>
+int command_thunk(Owner* self, int argc, char** argv) {
+  return (self->*MemberFunc)(argc, argv);
 }
 
 /**
- * @brief 打印 uint8 值
+ * @brief 降采样时一个输出周期内多次采集的规约方式
  */
-inline void print_u8_value(const char* name, uint8_t value) {
-  LibXR::STDIO::Printf<"  %s=%u\r\n">(name, static_cast<unsigned>(value));
-}
+enum class Reduction : uint8_t {
+  DEFAULT,  ///< F32 取平均，其余取最后值
+  LAST,     ///< 最后一次采集
+  AVG,      ///< 平均值
+  MIN,      ///< 最小值
+  MAX,      ///< 最大值
+  PEAK,     ///< 绝对值最大的采集值（保留符号），用于峰值保持
+};
 
 /**
- * @brief 打印 float 值
+ * @brief 编译期格式字符串
+ * @tparam N 字符串长度（含结尾 0）
  */
-inline void print_f32_value(const char* name, float value) {
-  LibXR::STDIO::Printf<"  %s=%.4f\r\n">(name, value);
-}
+template <size_t N>
+struct FormatString {
+  char data[N];
+
+  constexpr FormatString(const char (&str)[N]) {  // NOLINT
+    for (size_t i = 0; i < N; ++i) {
+      data[i] = str[i];
+    }
+  }
+};
 
 /**
- * @brief Live 模式字段描述
+ * @brief 字段值类型
  */
-template <typename Owner>
-struct LiveFieldDesc {
-  const char* name;
-  ViewMask view_mask;
-  void (*print)(const char* name, const Owner* self);
+enum class FieldType : uint8_t {
+  CUSTOM = 0,  ///< 自定义打印，二进制模式下按原始字节输出
+  BOOL = 1,
+  U8 = 2,
+  F32 = 3,
+  I8 = 4,
+  I16 = 5,
+  U16 = 6,
+  I32 = 7,
+  U32 = 8,
+  I64 = 9,
+  U64 = 10,
+  F64 = 11,
 };
 
 /**
- * @brief Live 模式命令执行器
- * @tparam Owner 模块类型
- * @tparam ViewCount 视图数量
+ * @brief 枚举名称表项
+ * @details 为枚举类型 E 在其所在命名空间（或类内以 friend）提供
+ *          `constexpr auto debug_core_enum_names(E)`，返回本类型的数组，
+ *          类型推导字段即按名称打印；表中没有的值按整数打印。
  */
-template <typename Owner, size_t ViewCount>
-int run_live_command(
-    Owner* self, const char* module_name, const char* view_help,
-    const std::array<ViewEntry<uint8_t>, ViewCount>& view_table,
-    const LiveFieldDesc<Owner>* fields, size_t field_count, int argc,
-    char** argv, uint8_t default_view, void (*lock_self)(Owner*) = nullptr,
-    void (*unlock_self)(Owner*) = nullptr) {
-  auto parse_view = [&](const char* arg, uint8_t* out_view) {
-    return parse_view_name(arg, view_table, out_view);
-  };
+template <typename E>
+struct EnumName {
+  const char* name;
+  E value;
+};
 
-  auto print_usage = [&]() {
-    LibXR::STDIO::Printf<"Usage:\r\n">();
-    LibXR::STDIO::Printf<"  monitor\r\n">();
-    LibXR::STDIO::Printf<"  monitor <time_ms> [interval_ms] [%s]\r\n">(
-                         view_help);
-    LibXR::STDIO::Printf<"  once [%s]\r\n">(view_help);
-    LibXR::STDIO::Printf<"  %s\r\n">(view_help);
-  };
+}  // namespace debug_core
 
-  auto print_once = [&](uint8_t view) {
-    if (lock_self != nullptr) {
-      lock_self(self);
-    }
+#if DEBUG_CORE_ENABLED
 
-    LibXR::STDIO::Printf<"[%u ms] %s %s\r\n">(
-        static_cast<unsigned>(LibXR::Thread::GetTime()), module_name,
-        view_name(view, view_table));
+namespace debug_core {
 
-    bool is_full_view = (view == default_view);
-    uint32_t selected_mask = view_bit(view);
-    for (size_t i = 0; i < field_count; ++i) {
-      const auto& f = fields[i];
-      if (!is_full_view && (f.view_mask & selected_mask) == 0) {
-        continue;
-      }
-      f.print(f.name, self);
-    }
+/**
+ * @brief stats 模式的逐字段滑动统计
+ * @details 用 Welford 算法在线累计计数、均值与二阶中心矩，长时间运行也不会
+ *          因大数相减丢失精度。同一会话内每次采样按相同顺序调用 Add()，字段
+ *          以调用顺序定位，无需查找。
+ */
+class StatsAccumulator {
+ public:
+  /**
+   * @brief 单字段统计量
+   */
+  struct FieldStats {
+    const char* group;  ///< 所属模块，单模块会话为空
+    const char* name;
+    uint32_t count;
+    float min;
+    float max;
+    double mean;
+    double m2;  ///< 与均值之差的平方和
 
-    if (unlock_self != nullptr) {
-      unlock_self(self);
+    double Stddev() const {
+      return count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : 0.0;
     }
   };
 
-  return run_command(argc, argv, default_view, parse_view, print_once,
-                     print_usage);
-}
+  /**
+   * @brief 开始一次采样
+   * @param timestamp_ms 采样时刻
+   */
+  void BeginSample(uint32_t timestamp_ms) {
+    if (samples_ == 0) {
+      first_ms_ = timestamp_ms;
+    }
+    last_ms_ = timestamp_ms;
+    ++samples_;
+    cursor_ = 0;
+  }
 
-/**
- * @brief Structured 模式命令执行器
- * @tparam Snapshot 快照类型
- */
-template <typename Snapshot>
-int run_structured_command(void* self,
-                           const StructuredProvider<Snapshot>& provider,
-                           int argc, char** argv, uint8_t default_view) {
-  auto print_usage = [&]() {
-    LibXR::STDIO::Printf<"Usage:\r\n">();
-    LibXR::STDIO::Printf<"  monitor\r\n">();
-    LibXR::STDIO::Printf<"  monitor <time_ms> [interval_ms] [%s]\r\n">(
-                         provider.view_help);
-    LibXR::STDIO::Printf<"  once [%s]\r\n">(provider.view_help);
-    LibXR::STDIO::Printf<"  %s\r\n">(provider.view_help);
-  };
+  /**
+   * @brief 累计一个字段值
+   */
+  void Add(const char* group, const char* name, double value) {
+    if (cursor_ >= DEBUG_CORE_STATS_MAX_FIELDS) {
+      overflow_ = true;
+      return;
+    }
+    FieldStats& f = fields_[cursor_];
+    if (cursor_ >= count_) {
+      f = FieldStats{group, name, 0, 0.0f, 0.0f, 0.0, 0.0};
+      count_ = cursor_ + 1;
+    }
+    ++cursor_;
 
-  auto print_once = [&](uint8_t view) {
-    Snapshot snapshot{};
-    provider.capture(self, &snapshot);
-
-    auto current_view_name =
-        provider.view_to_string ? provider.view_to_string(view) : "unknown";
-    LibXR::STDIO::Printf<"[%u ms] %s %s\r\n">(
-        static_cast<unsigned>(LibXR::Thread::GetTime()), provider.module_name,
-        current_view_name);
-
-    bool is_full_view = (view == default_view);
-    uint32_t selected_mask = view_bit(view);
-    const uint8_t* base = reinterpret_cast<const uint8_t*>(&snapshot);
-    for (size_t i = 0; i < provider.field_count; ++i) {
-      const auto& f = provider.fields[i];
-      if (!is_full_view && (f.view_mask & selected_mask) == 0) {
-        continue;
-      }
-      const void* field_ptr = base + f.offset;
-      f.print(f.name, field_ptr);
+    float sample = static_cast<float>(value);
+    if (f.count == 0 || sample < f.min) {
+      f.min = sample;
     }
-  };
+    if (f.count == 0 || sample > f.max) {
+      f.max = sample;
+    }
+    ++f.count;
+    double delta = value - f.mean;
+    f.mean += delta / static_cast<double>(f.count);
+    f.m2 += delta * (value - f.mean);
+  }
 
-  return run_command(argc, argv, default_view, provider.parse_view, print_once,
-                     print_usage);
-}
+  /**
+   * @brief 清空统计，开始新窗口
+   */
+  void Reset() {
+    samples_ = 0;
+    count_ = 0;
+    cursor_ = 0;
+    overflow_ = false;
+  }
 
-}  // namespace debug_core
+  uint32_t Samples() const { return samples_; }
+  size_t FieldCount() const { return count_; }
+  const FieldStats& Field(size_t index) const { return fields_[index]; }
+  uint32_t FirstMs() const { return first_ms_; }
+  uint32_t LastMs() const { return last_ms_; }
+  bool Overflow() const { return overflow_; }
 
-#define DEBUG_CORE_FIELD_CUSTOM(SnapshotType, member, mask, printer) \
-  {#member, offsetof(SnapshotType, member), (mask), (printer)}
-#define DEBUG_CORE_FIELD_F32(SnapshotType, member, mask) \
-  DEBUG_CORE_FIELD_CUSTOM(SnapshotType, member, (mask),  \
-                          debug_core::print_f32_field)
-#define DEBUG_CORE_FIELD_BOOL(SnapshotType, member, mask) \
-  DEBUG_CORE_FIELD_CUSTOM(SnapshotType, member, (mask),   \
-                          debug_core::print_bool_field)
-#define DEBUG_CORE_FIELD_U8(SnapshotType, member, mask) \
-  DEBUG_CORE_FIELD_CUSTOM(SnapshotType, member, (mask), \
-                          debug_core::print_u8_field)
-
-#define DEBUG_CORE_LIVE_F32(OwnerType, name, mask, expr)                  \
-  {(name), (mask), +[](const char* field_name, const OwnerType* self) {   \
-     debug_core::print_f32_value(field_name, static_cast<float>((expr))); \
-   }}
-#define DEBUG_CORE_LIVE_BOOL(OwnerType, name, mask, expr)                 \
-  {(name), (mask), +[](const char* field_name, const OwnerType* self) {   \
-     debug_core::print_bool_value(field_name, static_cast<bool>((expr))); \
-   }}
-#define DEBUG_CORE_LIVE_U8(OwnerType, name, mask, expr)                    \
-  {(name), (mask), +[](const char* field_name, const OwnerType* self) {    \
-     debug_core::print_u8_value(field_name, static_cast<uint8_t>((expr))); \
-   }}
-#define DEBUG_CORE_LIVE_CUSTOM(OwnerType, name, mask, printer) \
-  {(name), (mask), (printer)}
+ private:
+  FieldStats fields_[DEBUG_CORE_STATS_MAX_FIELDS];
+  size_t count_ = 0;
+  size_t cursor_ = 0;
+  uint32_t samples_ = 0;
+  uint32_t first_ms_ = 0;
+  uint32_t last_ms_ = 0;
+  bool overflow_ = false;
+};
 
 /**
- * @brief DebugCore 占位应用模块
- * @details 该类本身不承载业务逻辑，主要用于满足模块化加载需求。
+ * @brief delta 模式的逐字段上次输出值缓存
+ * @details 与 StatsAccumulator 相同，同一会话内每帧按相同顺序调用 Update()，
+ *          字段以调用顺序定位。不超过 4 字节的值按原始字节比较，更长的值（
+ *          快照中的自定义字段、Live 自定义字段文本）按 FNV-1a 摘要比较；
+ *          浮点字段可设置死区，只与上次输出的值比较，缓慢漂移最终也会输出。
  */
-class DebugCore : public LibXR::Application {
+class DeltaCache {
  public:
   /**
-   * @brief 构造 DebugCore 模块
+   * @brief 开始一帧
+   * @param keyframe 关键帧输出全部字段并刷新缓存
    */
-  DebugCore(LibXR::HardwareContainer& hw, LibXR::ApplicationManager& app) {
-    UNUSED(hw);
-    UNUSED(app);
+  void BeginFrame(bool keyframe) {
+    keyframe_ = keyframe;
+    cursor_ = 0;
   }
 
+  bool Keyframe() const { return keyframe_; }
+
   /**
-   * @brief 监控回调
+   * @brief 判断字段是否需要输出，需要时记为已输出
+   * @param is_float 是否为 float 字段，仅 float 字段使用死区
+   * @param deadband 死区，0 表示任意变化都输出
+   * @return bool 需要输出返回 true
    */
-  void OnMonitor() override {}
+  bool Update(const void* data, size_t size, bool is_float, float deadband) {
+    if (cursor_ >= DEBUG_CORE_DELTA_MAX_FIELDS) {
+      return true;
+    }
+    Slot& slot = slots_[cursor_++];
+
+    uint32_t key = 0;
+    if (size <= sizeof(key)) {
+      std::memcpy(&key, data, size);
+    } else {
+      key = 2166136261u;
+      for (size_t i = 0; i < size; ++i) {
+        key = (key ^ static_cast<const uint8_t*>(data)[i]) * 16777619u;
+      }
+    }
+    float value = 0.0f;
+    if (is_float) {
+      std::memcpy(&value, data, sizeof(value));
+    }
+
+    if (!keyframe_ && slot.valid) {
+      if (key == slot.key) {
+        return false;
+      }
+      if (is_float && deadband > 0.0f &&
+          std::fabs(value - slot.value) <= deadband) {
+        return false;
+      }
+    }
+    slot.key = key;
+    slot.value = value;
+    slot.valid = true;
+    return true;
+  }
+
+ private:
+  struct Slot {
+    uint32_t key = 0;
+    float value = 0.0f;
+    bool valid = false;
+  };
+
+  Slot slots_[DEBUG_CORE_DELTA_MAX_FIELDS];
+  size_t cursor_ = 0;
+  bool keyframe_ = true;
 };
+
+/**
+ * @brief 解析规约方式名称
+ */
+inline bool parse_reduction(const char* arg, Reduction* out) {
+  static constexpr struct {
+    const char* name;
+    Reduction mode;
+  } MODES[] = {{"last", Reduction::LAST}, {"avg", Reduction::AVG},
+               {"min", Reduction::MIN},   {"max", Reduction::MAX},
+               {"peak", Reduction::PEAK}};
+  for (const auto& item : MODES) {
+    if (std::strcmp(arg, item.name) == 0) {
+      *out = item.mode;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 降采样的逐字段规约器
+ * @details 与 StatsAccumulator 相同，每次采集按相同顺序调用 Add()，字段以
+ *          调用顺序定位；输出时再按相同顺序调用 Take() 取出规约值并清空，
+ *          开始下一个输出周期。
+ */
+class Reducer {
+ public:
+  /**
+   * @param override_mode 命令行指定的规约方式，DEFAULT 表示使用字段自身设置
+   */
+  explicit Reducer(Reduction override_mode = Reduction::DEFAULT)
+      : override_(override_mode) {}
+
+  /**
+   * @brief 开始一次采集
+   */
+  void BeginCapture() { cursor_ = 0; }
+
+  /**
+   * @brief 累计一个字段值
+   */
+  void Add(double value) {
+    if (cursor_ >= DEBUG_CORE_REDUCE_MAX_FIELDS) {
+      return;
+    }
+    Slot& slot = slots_[cursor_++];
+    float sample = static_cast<float>(value);
+    if (slot.count == 0) {
+      slot.sum = 0.0;
+      slot.min = sample;
+      slot.max = sample;
+      slot.peak = sample;
+    }
+    slot.sum += value;
+    if (sample < slot.min) {
+      slot.min = sample;
+    }
+    if (sample > slot.max) {
+      slot.max = sample;
+    }
+    if (std::fabs(sample) > std::fabs(slot.peak)) {
+      slot.peak = sample;
+    }
+    slot.last = value;
+    ++slot.count;
+  }
+
+  /**
+   * @brief 开始输出本周期的规约结果
+   */
+  void BeginOutput() { cursor_ = 0; }
+
+  /**
+   * @brief 取出一个字段的规约值并清空该字段
+   * @param field_mode 字段自身的规约方式
+   * @param is_float 是否为 float 字段，决定 DEFAULT 的含义
+   * @param fallback 未累计（超出容量）时返回的值
+   */
+  double Take(Reduction field_mode, bool is_float, double fallback) {
+    if (cursor_ >= DEBUG_CORE_REDUCE_MAX_FIELDS) {
+      return fallback;
+    }
+    Slot& slot = slots_[cursor_++];
+    if (slot.count == 0) {
+      return fallback;
+    }
+    Reduction mode = override_ != Reduction::DEFAULT ? override_ : field_mode;
+    if (mode == Reduction::DEFAULT) {
+      mode = is_float ? Reduction::AVG : Reduction::LAST;
+    }
+    double result = slot.last;
+    switch (mode) {
+      case Reduction::AVG:
+        result = slot.sum / static_cast<double>(slot.count);
+        break;
+      case Reduction::MIN:
+        result = slot.min;
+        break;
+      case Reduction::MAX:
+        result = slot.max;
+        break;
+      case Reduction::PEAK:
+        result = slot.peak;
+        break;
+      default:
+        break;
+    }
+    slot.count = 0;
+    return result;
+  }
+
+ private:
+  struct Slot {
+    double sum = 0.0;
+    double last = 0.0;
+    float min = 0.0f;
+    float max = 0.0f;
+    float peak = 0.0f;
+    uint32_t count = 0;
+  };
+
+  Slot slots_[DEBUG_CORE_REDUCE_MAX_FIELDS];
+  size_t cursor_ = 0;
+  Reduction override_;
+};
+
+/**
+ * @brief prof 模式统计的帧内阶段
+ */
+enum class ProfileStage : uint8_t {
+  CAPTURE,  ///< 读取模块状态（含 lock_self 加锁等待）
+  FORMAT,   ///< 格式化与会话处理（stats / delta / 降采样）
+  WRITE,    ///< 写出到终端
+  FRAME,    ///< 整帧
+  NUMBER,
+};
+
+/**
+ * @brief prof 模式的 monitor 自身耗时统计
+ * @details 采集与写出在各自调用点计时并累加到当前帧；帧结束时由整帧耗时减去
+ *          两者得到格式化耗时，因此三段之和恰为整帧耗时。时钟为
+ *          DEBUG_CORE_PROFILE_CLOCK_US()，计时本身不分配内存也不加锁。
+ */
+class MonitorProfile {
+ public:
+  /**
+   * @brief 单个阶段的逐帧耗时统计（微秒）
+   */
+  struct StageStats {
+    uint32_t min_us = std::numeric_limits<uint32_t>::max();
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+  };
+
+  static uint32_t Now() { return DEBUG_CORE_PROFILE_CLOCK_US(); }
+
+  /**
+   * @brief 累加当前帧某阶段的耗时
+   */
+  void Add(ProfileStage stage, uint32_t us) {
+    pending_[static_cast<size_t>(stage)] += us;
+  }
+
+  /**
+   * @brief 结束当前帧
+   * @param frame_us 整帧耗时
+   */
+  void EndFrame(uint32_t frame_us) {
+    uint32_t capture_us = pending_[static_cast<size_t>(ProfileStage::CAPTURE)];
+    uint32_t write_us = pending_[static_cast<size_t>(ProfileStage::WRITE)];
+    uint32_t measured = capture_us + write_us;
+    Record(ProfileStage::CAPTURE, capture_us);
+    Record(ProfileStage::WRITE, write_us);
+    Record(ProfileStage::FORMAT, frame_us > measured ? frame_us - measured : 0);
+    Record(ProfileStage::FRAME, frame_us);
+    for (uint32_t& us : pending_) {
+      us = 0;
+    }
+    ++frames_;
+  }
+
+  uint32_t Frames() const { return frames_; }
+
+  const StageStats& Stage(ProfileStage stage) const {
+    return stages_[static_cast<size_t>(stage)];
+  }
+
+ private:
+  static constexpr size_t STAGE_COUNT =
+      static_cast<size_t>(ProfileStage::NUMBER);
+
+  void Record(ProfileStage stage, uint32_t us) {
+    StageStats& s = stages_[static_cast<size_t>(stage)];
+    s.min_us = us < s.min_us ? us : s.min_us;
+    s.max_us = us > s.max_us ? us : s.max_us;
+    s.total_us += us;
+  }
+
+  StageStats stages_[STAGE_COUNT];
+  uint32_t pending_[STAGE_COUNT] = {};
+  uint32_t frames_ = 0;
+};
+
+/**
+ * @brief 输出一个统计窗口，定义见 FrameWriter 之后
+ */
+inline void print_stats(const StatsAccumulator& stats);
+
+/**
+ * @brief 输出格式
+ */
+enum class OutputFormat : uint8_t {
+  TEXT,    ///< 文本，每字段一行
+  BINARY,  ///< COBS 分帧的二进制采样，见 DebugCoreBinary.hpp
+};
+
+/**
+ * @brief 单次 once/monitor 会话的输出上下文
+ */
+struct FrameContext {
+  OutputFormat format = OutputFormat::TEXT;
+  bool stats = false;            ///< stats 模式：只累计统计，不逐帧输出
+  bool delta = false;            ///< delta 模式：只输出变化的字段
+  bool prof = false;             ///< prof 模式：会话结束时输出自身耗时
+  Reduction reduce = Reduction::DEFAULT;  ///< 降采样：命令行指定的规约方式
+  bool reduce_emit = true;       ///< 降采样：本次采集后是否输出一帧
+  uint32_t sequence = 0;  ///< 会话内帧序号，0 表示首帧
+  uint32_t stats_every = 0;      ///< 每 K 次采样输出一次统计，0 表示仅结束时
+  uint32_t delta_keyframe = DEBUG_CORE_DELTA_KEYFRAME_INTERVAL;  ///< 关键帧间隔
+  uint32_t sample_ms = 0;        ///< 降采样：采集周期，0 表示与输出周期相同
+  // 以下由会话在栈上分配并设置，仅在会话内有效
+  StatsAccumulator* accumulator = nullptr;
+  DeltaCache* delta_cache = nullptr;
+  Reducer* reducer = nullptr;
+  MonitorProfile* profile = nullptr;
+
+  /**
+   * @brief delta 模式下开始一帧
+   * @return bool 本帧为关键帧（或非 delta 模式）时返回 true
+   */
+  bool BeginDeltaFrame() const {
+    if (delta_cache == nullptr) {
+      return true;
+    }
+    delta_cache->BeginFrame(sequence % delta_keyframe == 0);
+    return delta_cache->Keyframe();
+  }
+
+  /**
+   * @brief 会话选项名称
+   * @return const char* 启用了 stats / delta / prof / 降采样之一时返回其选项名，
+   *         否则返回 nullptr
+   */
+  const char* SessionOption() const {
+    if (stats) {
+      return "stats";
+    }
+    if (delta) {
+      return "delta";
+    }
+    if (prof) {
+      return "prof";
+    }
+    return sample_ms > 0 ? "sample" : nullptr;
+  }
+
+  /**
+   * @brief prof 模式下开始计时一个阶段
+   * @return uint32_t 起始时刻，未启用 prof 时为 0
+   */
+  uint32_t ProfileBegin() const {
+    return profile != nullptr ? MonitorProfile::Now() : 0;
+  }
+
+  /**
+   * @brief prof 模式下结束计时并计入当前帧
+   */
+  void ProfileEnd(ProfileStage stage, uint32_t begin) const {
+    if (profile != nullptr) {
+      profile->Add(stage, MonitorProfile::Now() - begin);
+    }
+  }
+};
+
+/**
+ * @brief 解析命令尾部的输出选项
+ * @param arg 参数字符串
+ * @param ctx 输出上下文
+ * @return bool 是输出选项时返回 true
+ */
+inline bool parse_output_option(const char* arg, FrameContext* ctx) {
+  if (std::strcmp(arg, "bin") == 0) {
+    ctx->format = OutputFormat::BINARY;
+    return true;
+  }
+  if (std::strcmp(arg, "stats") == 0) {
+    ctx->stats = true;
+    return true;
+  }
+  if (std::strncmp(arg, "stats:", 6) == 0) {
+    int every = std::atoi(arg + 6);
+    if (every <= 0) {
+      return false;
+    }
+    ctx->stats = true;
+    ctx->stats_every = static_cast<uint32_t>(every);
+    return true;
+  }
+  if (std::strcmp(arg, "prof") == 0) {
+    ctx->prof = true;
+    return true;
+  }
+  if (std::strcmp(arg, "delta") == 0) {
+    ctx->delta = true;
+    return true;
+  }
+  if (std::strncmp(arg, "delta:", 6) == 0) {
+    int keyframe = std::atoi(arg + 6);
+    if (keyframe <= 0) {
+      return false;
+    }
+    ctx->delta = true;
+    ctx->delta_keyframe = static_cast<uint32_t>(keyframe);
+    return true;
+  }
+  if (std::strncmp(arg, "sample:", 7) == 0) {
+    char* end = nullptr;
+    long sample_ms = std::strtol(arg + 7, &end, 10);
+    Reduction mode = Reduction::DEFAULT;
+    if (sample_ms <= 0 || end == arg + 7 ||
+        (*end == ':' && !parse_reduction(end + 1, &mode)) ||
+        (*end != ':' && *end != '\0')) {
+      return false;
+    }
+    ctx->sample_ms = static_cast<uint32_t>(sample_ms);
+    ctx->reduce = mode;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief 调用单次打印回调并推进帧序号
+ * @details 回调可选择接收 FrameContext；只接收视图参数的回调仅支持文本输出。
+ */
+template <typename View, typename PrintOnceFn>
+void invoke_print_once(PrintOnceFn& print_once, View view, FrameContext& ctx) {
+  if constexpr (std::is_invocable_v<PrintOnceFn&, View, const FrameContext&>) {
+    print_once(view, static_cast<const FrameContext&>(ctx));
+  } else {
+    print_once(view);
+  }
+  // 降采样时只有输出帧推进帧序号
+  if (ctx.reducer == nullptr || ctx.reduce_emit) {
+    ++ctx.sequence;
+  }
+}
+
+/**
+ * @brief monitor 调度统计
+ */
+struct MonitorTiming {
+  uint32_t frames = 0;        ///< 实际输出帧数
+  uint32_t overruns = 0;      ///< 帧结束时已错过下一截止时间的次数
+  uint32_t skipped = 0;       ///< 因超时整体跳过的调度槽数
+  uint32_t max_late_ms = 0;   ///< 帧开始时刻相对截止时间的最大延迟
+  uint32_t first_frame_ms = 0;  ///< 首帧开始时刻
+  uint32_t last_frame_ms = 0;   ///< 末帧开始时刻
+  // 以下仅降采样时有效：frames 等统计按采集计，输出帧单独统计
+  uint32_t outputs = 0;          ///< 实际输出帧数
+  uint32_t first_output_ms = 0;  ///< 首个输出帧的采集时刻
+  uint32_t last_output_ms = 0;   ///< 末个输出帧的采集时刻
+};
+
+/**
+ * @brief 休眠到指定时刻
+ * @param deadline_ms 目标时刻
+ * @param stop 停止请求，非空时按 DEBUG_CORE_JOB_STOP_POLL_MS 分段休眠
+ */
+inline void sleep_until(uint32_t deadline_ms, const std::atomic<bool>* stop) {
+  for (;;) {
+    int32_t remain = static_cast<int32_t>(
+        deadline_ms - static_cast<uint32_t>(LibXR::Thread::GetTime()));
+    if (remain <= 0 || (stop != nullptr && stop->load())) {
+      return;
+    }
+    uint32_t step = static_cast<uint32_t>(remain);
+    if (stop != nullptr && step > DEBUG_CORE_JOB_STOP_POLL_MS) {
+      step = DEBUG_CORE_JOB_STOP_POLL_MS;
+    }
+    LibXR::Thread::Sleep(step);
+  }
+}
+
+/**
+ * @brief 按绝对截止时间调度 monitor 帧
+ * @details 第 k 帧的截止时间固定为 start + k * interval_ms，帧本身的采集与打印
+ *          耗时不会累积到周期上。帧结束时若已错过下一截止时间计为一次超时；
+ *          整个错过的槽直接跳过，保证后续帧仍落在原始时间网格上。
+ * @tparam FrameFn 单帧回调类型，签名 void(uint32_t slot_ms)，slot_ms 为本帧
+ *         调度槽相对会话开始的时刻
+ * @param time_ms 总时长
+ * @param interval_ms 帧周期
+ * @param frame 单帧回调
+ * @param stop 停止请求，可为空
+ * @return MonitorTiming 调度统计
+ */
+template <typename FrameFn>
+MonitorTiming run_monitor_schedule(uint32_t time_ms, uint32_t interval_ms,
+                                   FrameFn frame,
+                                   const std::atomic<bool>* stop = nullptr) {
+  MonitorTiming timing;
+  const uint32_t start = static_cast<uint32_t>(LibXR::Thread::GetTime());
+  uint32_t slot = 0;
+
+  while (slot < time_ms && (stop == nullptr || !stop->load())) {
+    uint32_t frame_begin = static_cast<uint32_t>(LibXR::Thread::GetTime());
+    uint32_t late = (frame_begin - start) - slot;
+    if (late > timing.max_late_ms) {
+      timing.max_late_ms = late;
+    }
+    if (timing.frames == 0) {
+      timing.first_frame_ms = frame_begin;
+    }
+    timing.last_frame_ms = frame_begin;
+
+    frame(slot);
+    ++timing.frames;
+    slot += interval_ms;
+
+    uint32_t since_start =
+        static_cast<uint32_t>(LibXR::Thread::GetTime()) - start;
+    if (since_start > slot) {
+      ++timing.overruns;
+      uint32_t missed = (since_start - slot) / interval_ms;
+      timing.skipped += missed;
+      slot += missed * interval_ms;
+    } else if (slot < time_ms) {
+      sleep_until(start + slot, stop);
+    }
+  }
+  return timing;
+}
+
+/**
+ * @brief 由帧数与首末帧时刻计算实际帧率
+ * @return float 帧率，帧数不足两帧时返回 target_hz
+ */
+inline float monitor_rate_hz(uint32_t frames, uint32_t first_ms,
+                             uint32_t last_ms, float target_hz) {
+  uint32_t span_ms = last_ms - first_ms;
+  if (frames > 1 && span_ms > 0) {
+    return static_cast<float>(frames - 1) * 1000.0f /
+           static_cast<float>(span_ms);
+  }
+  return target_hz;
+}
+
+/**
+ * @brief 打印 monitor 调度统计
+ * @param timing 调度统计
+ * @param interval_ms 期望输出周期
+ * @param sample_ms 降采样的采集周期，0 表示未降采样；非 0 时第一行按采集
+ *        统计，另起一行给出输出帧数与输出帧率
+ */
+inline void print_monitor_summary(const MonitorTiming& timing,
+                                  uint32_t interval_ms,
+                                  uint32_t sample_ms = 0) {
+  float target_hz =
+      1000.0f / static_cast<float>(sample_ms > 0 ? sample_ms : interval_ms);
+  float achieved_hz = monitor_rate_hz(timing.frames, timing.first_frame_ms,
+                                      timing.last_frame_ms, target_hz);
+  LibXR::STDIO::Printf<"[monitor] frames=%u overruns=%u skipped=%u "
+                       "rate=%.2f/%.2f Hz max_late=%u ms\r\n">(
+      static_cast<unsigned>(timing.frames),
+      static_cast<unsigned>(timing.overruns),
+      static_cast<unsigned>(timing.skipped), achieved_hz, target_hz,
+      static_cast<unsigned>(timing.max_late_ms));
+  if (sample_ms == 0) {
+    return;
+  }
+  float output_target_hz = 1000.0f / static_cast<float>(interval_ms);
+  float output_hz =
+      monitor_rate_hz(timing.outputs, timing.first_output_ms,
+                      timing.last_output_ms, output_target_hz);
+  LibXR::STDIO::Printf<"[monitor] outputs=%u rate=%.2f/%.2f Hz\r\n">(
+      static_cast<unsigned>(timing.outputs), output_hz, output_target_hz);
+}
+
+/**
+ * @brief 打印 prof 模式的自身耗时统计
+ * @param profile 耗时统计
+ * @param wall_ms 会话墙钟时长
+ */
+inline void print_monitor_profile(const MonitorProfile& profile,
+                                  uint32_t wall_ms) {
+  if (profile.Frames() == 0) {
+    return;
+  }
+  const float frames = static_cast<float>(profile.Frames());
+  const float busy_ms =
+      static_cast<float>(profile.Stage(ProfileStage::FRAME).total_us) /
+      1000.0f;
+  const float share = wall_ms > 0 ? busy_ms / static_cast<float>(wall_ms)
+                                  : 0.0f;
+  LibXR::STDIO::Printf<"[profile] frames=%u busy=%.3f ms wall=%u ms "
+                       "share=%.4f\r\n">(
+      static_cast<unsigned>(profile.Frames()), busy_ms,
+      static_cast<unsigned>(wall_ms), share);
+  // 名称按列对齐
+  static constexpr const char* NAMES[] = {"capture", "format ", "write  ",
+                                          "frame  "};
+  for (size_t i = 0; i < static_cast<size_t>(ProfileStage::NUMBER); ++i) {
+    const auto& stage = profile.Stage(static_cast<ProfileStage>(i));
+    LibXR::STDIO::Printf<"  %s min=%u avg=%.1f max=%u us\r\n">(
+        NAMES[i], static_cast<unsigned>(stage.min_us),
+        static_cast<float>(stage.total_us) / frames,
+        static_cast<unsigned>(stage.max_us));
+  }
+}
+
+/**
+ * @brief 按会话模式调度采集与输出
+ * @details stats / delta / 降采样 / prof 的会话状态只在启用时分配在栈上：
+ *          缺少哪项就分配后递归调用自身。降采样时按 sample_ms 采集，采集槽
+ *          越过下一个 interval_ms 输出截止时刻时输出一帧。
+ * @return MonitorTiming 按采集周期统计的调度结果
+ */
+template <typename View, typename PrintOnceFn>
+MonitorTiming run_monitor_frames(PrintOnceFn& print_once, View view,
+                                 FrameContext& ctx, uint32_t time_ms,
+                                 uint32_t interval_ms,
+                                 const std::atomic<bool>* stop) {
+  if (ctx.stats && ctx.accumulator == nullptr) {
+    StatsAccumulator stats;
+    ctx.accumulator = &stats;
+    auto timing =
+        run_monitor_frames(print_once, view, ctx, time_ms, interval_ms, stop);
+    if (stats.Samples() > 0) {
+      print_stats(stats);
+    }
+    ctx.accumulator = nullptr;
+    return timing;
+  }
+  if (ctx.delta && ctx.delta_cache == nullptr) {
+    DeltaCache delta;
+    ctx.delta_cache = &delta;
+    auto timing =
+        run_monitor_frames(print_once, view, ctx, time_ms, interval_ms, stop);
+    ctx.delta_cache = nullptr;
+    return timing;
+  }
+  if (ctx.sample_ms > 0 && ctx.reducer == nullptr) {
+    Reducer reducer(ctx.reduce);
+    ctx.reducer = &reducer;
+    auto timing =
+        run_monitor_frames(print_once, view, ctx, time_ms, interval_ms, stop);
+    ctx.reducer = nullptr;
+    return timing;
+  }
+
+  if (ctx.prof && ctx.profile == nullptr) {
+    MonitorProfile profile;
+    ctx.profile = &profile;
+    const uint32_t begin_ms = static_cast<uint32_t>(LibXR::Thread::GetTime());
+    auto timing =
+        run_monitor_frames(print_once, view, ctx, time_ms, interval_ms, stop);
+    print_monitor_profile(
+        profile, static_cast<uint32_t>(LibXR::Thread::GetTime()) - begin_ms);
+    ctx.profile = nullptr;
+    return timing;
+  }
+
+  auto frame = [&]() {
+    const uint32_t begin = ctx.ProfileBegin();
+    invoke_print_once(print_once, view, ctx);
+    StatsAccumulator* stats = ctx.accumulator;
+    if (stats != nullptr && ctx.stats_every > 0 &&
+        stats->Samples() >= ctx.stats_every) {
+      print_stats(*stats);
+      stats->Reset();
+    }
+    if (ctx.profile != nullptr) {
+      ctx.profile->EndFrame(MonitorProfile::Now() - begin);
+    }
+  };
+  if (ctx.reducer == nullptr) {
+    return run_monitor_schedule(
+        time_ms, interval_ms, [&](uint32_t) { frame(); }, stop);
+  }
+
+  // 按采集槽时刻而不是已执行的采集次数决定输出：超时跳过的槽同样计入，
+  // 输出周期不会因此拉长
+  uint32_t next_output_ms = interval_ms;
+  uint32_t outputs = 0;
+  uint32_t first_output_ms = 0;
+  uint32_t last_output_ms = 0;
+  auto timing = run_monitor_schedule(
+      time_ms, ctx.sample_ms,
+      [&](uint32_t slot_ms) {
+        const uint32_t capture_end_ms = slot_ms + ctx.sample_ms;
+        ctx.reduce_emit = capture_end_ms >= next_output_ms;
+        if (ctx.reduce_emit) {
+          while (next_output_ms <= capture_end_ms) {
+            next_output_ms += interval_ms;
+          }
+          last_output_ms = static_cast<uint32_t>(LibXR::Thread::GetTime());
+          if (outputs++ == 0) {
+            first_output_ms = last_output_ms;
+          }
+        }
+        frame();
+      },
+      stop);
+  timing.outputs = outputs;
+  timing.first_output_ms = first_output_ms;
+  timing.last_output_ms = last_output_ms;
+  return timing;
+}
+
+/**
+ * @brief 运行一次完整的 monitor 会话
+ * @tparam View 视图类型
+ * @tparam PrintOnceFn 单次打印回调类型
+ * @return MonitorTiming 调度统计
+ */
+template <typename View, typename PrintOnceFn>
+MonitorTiming run_monitor_session(PrintOnceFn& print_once, View view,
+                                  FrameContext ctx, uint32_t time_ms,
+                                  uint32_t interval_ms,
+                                  const std::atomic<bool>* stop = nullptr) {
+  auto timing =
+      run_monitor_frames(print_once, view, ctx, time_ms, interval_ms, stop);
+  // 二进制流中不混入文本统计行
+  if (ctx.format == OutputFormat::TEXT) {
+    print_monitor_summary(timing, interval_ms, ctx.sample_ms);
+  }
+  return timing;
+}
+
+/**
+ * @brief 后台 monitor 任务表
+ * @details 每个任务槽对应一个首次使用时创建的常驻工作线程，空闲时阻塞在信号量
+ *          上。提交任务时把打印回调按值拷贝进任务槽，因此回调不能按引用捕获
+ *          调用方的局部变量；字段表、视图表等需具有静态生命周期。
+ */
+class MonitorJobs {
+ public:
+  /**
+   * @brief 获取全局任务表
+   */
+  static MonitorJobs& Instance() {
+    static MonitorJobs jobs;
+    return jobs;
+  }
+
+  /**
+   * @brief 提交后台 monitor 任务
+   * @tparam View 视图类型
+   * @tparam PrintOnceFn 单次打印回调类型
+   * @param label 任务描述，用于 jobs 列表
+   * @return int 任务编号，失败返回 -1
+   */
+  template <typename View, typename PrintOnceFn>
+  int Start(const char* label, const PrintOnceFn& print_once, View view,
+            const FrameContext& ctx, uint32_t time_ms, uint32_t interval_ms) {
+    using Task = JobTask<View, PrintOnceFn>;
+    static_assert(sizeof(Task) <= DEBUG_CORE_JOB_CONTEXT_SIZE,
+                  "print callback too large, raise DEBUG_CORE_JOB_CONTEXT_SIZE");
+    static_assert(alignof(Task) <= alignof(std::max_align_t));
+
+    LibXR::Mutex::LockGuard lock_guard(mutex_);
+    for (size_t i = 0; i < DEBUG_CORE_MAX_JOBS; ++i) {
+      Job& job = jobs_[i];
+      if (job.state.load() != JobState::IDLE) {
+        continue;
+      }
+
+      new (job.storage) Task{print_once, view, ctx};
+      job.run = &RunTask<Task>;
+      job.time_ms = time_ms;
+      job.interval_ms = interval_ms;
+      job.started_ms = static_cast<uint32_t>(LibXR::Thread::GetTime());
+      std::strncpy(job.label, label, sizeof(job.label) - 1);
+      job.label[sizeof(job.label) - 1] = '\0';
+      job.stop.store(false);
+      job.state.store(JobState::RUNNING);
+
+      if (!job.thread_created) {
+        job.thread.Create<Job*>(&job, WorkerMain, "debug_job",
+                                DEBUG_CORE_JOB_STACK_SIZE,
+                                DEBUG_CORE_JOB_PRIORITY);
+        job.thread_created = true;
+      }
+      job.wake.Post();
+      return static_cast<int>(i + 1);
+    }
+    return -1;
+  }
+
+  /**
+   * @brief 请求停止任务
+   * @param id 任务编号，0 表示全部
+   * @return int 收到停止请求的任务数
+   */
+  int Stop(int id) {
+    int count = 0;
+    for (size_t i = 0; i < DEBUG_CORE_MAX_JOBS; ++i) {
+      if (id != 0 && static_cast<size_t>(id) != i + 1) {
+        continue;
+      }
+      JobState expected = JobState::RUNNING;
+      if (jobs_[i].state.compare_exchange_strong(expected,
+                                                 JobState::STOPPING)) {
+        jobs_[i].stop.store(true);
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief 打印任务列表
+   */
+  void List() {
+    uint32_t now = static_cast<uint32_t>(LibXR::Thread::GetTime());
+    int count = 0;
+    for (size_t i = 0; i < DEBUG_CORE_MAX_JOBS; ++i) {
+      const Job& job = jobs_[i];
+      JobState state = job.state.load();
+      if (state == JobState::IDLE) {
+        continue;
+      }
+      LibXR::STDIO::Printf<"  [%u] %s  %u/%u ms  every %u ms  %s\r\n">(
+          static_cast<unsigned>(i + 1), job.label,
+          static_cast<unsigned>(now - job.started_ms),
+          static_cast<unsigned>(job.time_ms),
+          static_cast<unsigned>(job.interval_ms),
+          state == JobState::RUNNING ? "running" : "stopping");
+      ++count;
+    }
+    if (count == 0) {
+      LibXR::STDIO::Printf<"  no background jobs\r\n">();
+    }
+  }
+
+ private:
+  enum class JobState : uint8_t { IDLE, RUNNING, STOPPING };
+
+  template <typename View, typename PrintOnceFn>
+  struct JobTask {
+    PrintOnceFn print_once;
+    View view;
+    FrameContext ctx;
+  };
+
+  struct Job {
+    std::atomic<JobState> state{JobState::IDLE};
+    std::atomic<bool> stop{false};
+    void (*run)(Job* job) = nullptr;
+    uint32_t time_ms = 0;
+    uint32_t interval_ms = 0;
+    uint32_t started_ms = 0;
+    char label[40] = {};
+    alignas(std::max_align_t) uint8_t storage[DEBUG_CORE_JOB_CONTEXT_SIZE];
+    bool thread_created = false;
+    LibXR::Semaphore wake;
+    LibXR::Thread thread;
+  };
+
+  template <typename Task>
+  static void RunTask(Job* job) {
+    auto* task = std::launder(reinterpret_cast<Task*>(job->storage));
+    run_monitor_session(task->print_once, task->view, task->ctx, job->time_ms,
+                        job->interval_ms, &job->stop);
+    task->~Task();
+  }
+
+  static void WorkerMain(Job* job) {
+    for (;;) {
+      if (job->wake.Wait(UINT32_MAX) != LibXR::ErrorCode::OK) {
+        continue;
+      }
+      job->run(job);
+      size_t id = static_cast<size_t>(job - Instance().jobs_) + 1;
+      LibXR::STDIO::Printf<"[job %u] %s %s\r\n">(
+          static_cast<unsigned>(id), job->label,
+          job->stop.load() ? "stopped" : "done");
+      job->state.store(JobState::IDLE);
+    }
+  }
+
+  LibXR::Mutex mutex_;
+  Job jobs_[DEBUG_CORE_MAX_JOBS];
+};
+
+/**
+ * @brief 拼接命令参数作为后台任务描述
+ */
+inline void join_args(int argc, char** argv, char* out, size_t size) {
+  size_t len = 0;
+  out[0] = '\0';
+  for (int i = 0; i < argc && len + 1 < size; ++i) {
+    int n = std::snprintf(out + len, size - len, i == 0 ? "%s" : " %s",
+                          argv[i]);
+    if (n < 0) {
+      break;
+    }
+    len += static_cast<size_t>(n);
+  }
+}
+
+/**
+ * @brief 通用命令解析执行器
+ * @details 支持 monitor 末尾追加 `&` 转为后台任务运行，后台任务会按值拷贝
+ *          print_once，要求其不按引用捕获调用方局部变量。
+ * @tparam View 视图类型
+ * @tparam ParseViewFn 视图解析回调类型
+ * @tparam PrintOnceFn 单次打印回调类型
+ * @tparam PrintUsageFn 帮助打印回调类型
+ * @return int 命令返回值
+ */
+template <typename View, typename ParseViewFn, typename PrintOnceFn,
+          typename PrintUsageFn>
+int run_command(int argc, char** argv, View default_view,
+                ParseViewFn parse_view, PrintOnceFn print_once,
+                PrintUsageFn print_usage) {
+  if (argc <= 1) {
+    print_usage();
+    return 0;
+  }
+
+  if (std::strcmp(argv[1], "jobs") == 0) {
+    MonitorJobs::Instance().List();
+    return 0;
+  }
+
+  if (std::strcmp(argv[1], "stop") == 0) {
+    if (argc != 3) {
+      LibXR::STDIO::Printf<"Error: Use stop <id|all>.\r\n">();
+      return -1;
+    }
+    int id = std::strcmp(argv[2], "all") == 0 ? 0 : std::atoi(argv[2]);
+    if (id < 0 || (id == 0 && std::strcmp(argv[2], "all") != 0)) {
+      LibXR::STDIO::Printf<"Error: Invalid job id '%s'.\r\n">(argv[2]);
+      return -1;
+    }
+    if (MonitorJobs::Instance().Stop(id) == 0) {
+      LibXR::STDIO::Printf<"Error: No running job '%s'.\r\n">(argv[2]);
+      return -1;
+    }
+    return 0;
+  }
+
+  bool background = false;
+  if (argc > 2 && std::strcmp(argv[argc - 1], "&") == 0) {
+    background = true;
+    --argc;
+  }
+
+  FrameContext ctx;
+  while (argc > 2 && parse_output_option(argv[argc - 1], &ctx)) {
+    --argc;
+  }
+  if (ctx.format != OutputFormat::TEXT &&
+      !std::is_invocable_v<PrintOnceFn&, View, const FrameContext&>) {
+    LibXR::STDIO::Printf<"Error: bin output is not supported here.\r\n">();
+    return -1;
+  }
+  if (const char* mode = ctx.SessionOption()) {
+    if (((ctx.stats || ctx.delta || ctx.prof) &&
+         ctx.format != OutputFormat::TEXT) ||
+        (ctx.stats && (ctx.delta || ctx.sample_ms > 0)) ||
+        !std::is_invocable_v<PrintOnceFn&, View, const FrameContext&>) {
+      LibXR::STDIO::Printf<"Error: %s output is not supported here.\r\n">(
+          mode);
+      return -1;
+    }
+    if (std::strcmp(argv[1], "monitor") != 0 || argc == 2) {
+      LibXR::STDIO::Printf<"Error: %s only applies to monitor <time_ms>."
+                           "\r\n">(mode);
+      return -1;
+    }
+  }
+
+  if (std::strcmp(argv[1], "monitor") == 0) {
+    if (argc == 2) {
+      invoke_print_once(print_once, default_view, ctx);
+      return 0;
+    }
+
+    if (argc > 5) {
+      LibXR::STDIO::Printf<"Error: Too many arguments for monitor.\r\n">();
+      return -1;
+    }
+
+    int time_ms = std::atoi(argv[2]);
+    int interval_ms = 1000;
+    View view = default_view;
+    bool third_is_view = false;
+
+    if (argc >= 4) {
+      View parsed_view = default_view;
+      if (parse_view(argv[3], &parsed_view)) {
+        view = parsed_view;
+        third_is_view = true;
+      } else {
+        interval_ms = std::atoi(argv[3]);
+      }
+    }
+
+    if (argc == 5) {
+      if (third_is_view) {
+        LibXR::STDIO::Printf<"Error: Invalid monitor args. Use monitor <time_ms> [interval_ms] "
+            "[view].\r\n">();
+        return -1;
+      }
+      if (!parse_view(argv[4], &view)) {
+        LibXR::STDIO::Printf<"Error: Unknown view '%s'.\r\n">(argv[4]);
+        return -1;
+      }
+    }
+
+    if (time_ms <= 0 || interval_ms <= 0) {
+      LibXR::STDIO::Printf<"Error: time_ms and interval_ms must be > 0.\r\n">();
+      return -1;
+    }
+    if (ctx.sample_ms > static_cast<uint32_t>(interval_ms)) {
+      LibXR::STDIO::Printf<"Error: sample period must be <= interval_ms.\r\n">();
+      return -1;
+    }
+
+    if (background) {
+      char label[40];
+      join_args(argc, argv, label, sizeof(label));
+      int id = MonitorJobs::Instance().Start(
+          label, print_once, view, ctx, static_cast<uint32_t>(time_ms),
+          static_cast<uint32_t>(interval_ms));
+      if (id < 0) {
+        LibXR::STDIO::Printf<"Error: No free job slot.\r\n">();
+        return -1;
+      }
+      LibXR::STDIO::Printf<"[%d] %s\r\n">(id, label);
+      return 0;
+    }
+
+    run_monitor_session(print_once, view, ctx, static_cast<uint32_t>(time_ms),
+                        static_cast<uint32_t>(interval_ms));
+    return 0;
+  }
+
+  if (background) {
+    LibXR::STDIO::Printf<"Error: '&' only applies to monitor <time_ms>.\r\n">();
+    return -1;
+  }
+
+  if (std::strcmp(argv[1], "once") == 0) {
+    if (argc > 3) {
+      LibXR::STDIO::Printf<"Error: Too many arguments for once.\r\n">();
+      return -1;
+    }
+
+    View view = default_view;
+    if (argc == 3 && !parse_view(argv[2], &view)) {
+      LibXR::STDIO::Printf<"Error: Unknown view '%s'.\r\n">(argv[2]);
+      return -1;
+    }
+
+    invoke_print_once(print_once, view, ctx);
+    return 0;
+  }
+
+  View direct_view = default_view;
+  if (argc == 2 && parse_view(argv[1], &direct_view)) {
+    invoke_print_once(print_once, direct_view, ctx);
+    return 0;
+  }
+
+  LibXR::STDIO::Printf<"Error: Unknown command '%s'.\r\n">(argv[1]);
+  return -1;
+}
+
+/**
+ * @brief 以单次写操作输出原始字节到 STDIO
+ * @param data 数据地址
+ * @param size 数据长度
+ * @return bool 写入成功返回 true
+ */
+inline bool write_bytes(const void* data, size_t size) {
+  if (size == 0) {
+    return true;
+  }
+  if (LibXR::STDIO::write_ == nullptr || !LibXR::STDIO::write_->Writable()) {
+    return false;
+  }
+  if (LibXR::STDIO::write_mutex_ == nullptr) {
+    LibXR::STDIO::write_mutex_ = new LibXR::Mutex();
+  }
+
+  LibXR::Mutex::LockGuard lock_guard(*LibXR::STDIO::write_mutex_);
+  static LibXR::WriteOperation op;
+  return (*LibXR::STDIO::write_)(LibXR::ConstRawData(data, size), op) ==
+         LibXR::ErrorCode::OK;
+}
+
+/**
+ * @brief 暂存缓冲区溢出策略
+ */
+enum class FrameOverflow : uint8_t {
+  TRUNCATE,  ///< 丢弃放不下的整行，帧尾追加截断标记
+  CHUNK,     ///< 在行边界处先输出已缓存内容，再继续写入
+};
+
+/**
+ * @brief 单帧格式化器
+ * @details 字段按行写入调用方提供的定长缓冲区，帧结束时通过 Flush() 一次性
+ *          写出，单帧的写操作次数只取决于字节数而与字段数无关。
+ *          缓冲区放不下时按 FrameOverflow 处理，任何情况下都不会越界。
+ */
+class FrameWriter {
+ public:
+  /// 截断标记，TRUNCATE 模式下始终为其预留空间
+  static constexpr char TRUNCATED_MARK[] = "  ...(truncated)\r\n";
+  static constexpr size_t TRUNCATED_MARK_LEN = sizeof(TRUNCATED_MARK) - 1;
+
+  /**
+   * @brief 构造格式化器
+   * @param buffer 缓冲区
+   * @param capacity 缓冲区大小
+   * @param overflow 溢出策略
+   */
+  FrameWriter(char* buffer, size_t capacity,
+              FrameOverflow overflow = DEBUG_CORE_FRAME_OVERFLOW_CHUNK
+                                           ? FrameOverflow::CHUNK
+                                           : FrameOverflow::TRUNCATE)
+      : buffer_(buffer), overflow_(overflow) {
+    // 预留 snprintf 结尾 0 的 1 字节，截断模式下再预留截断标记
+    size_t reserve = 1;
+    if (overflow_ == FrameOverflow::TRUNCATE) {
+      reserve += TRUNCATED_MARK_LEN;
+    }
+    limit_ = capacity > reserve ? capacity - reserve : 0;
+  }
+
+  FrameWriter(const FrameWriter&) = delete;
+  FrameWriter& operator=(const FrameWriter&) = delete;
+
+  /**
+   * @brief 按格式追加内容
+   * @tparam Fmt 编译期格式字符串
+   */
+  template <FormatString Fmt, typename... Args>
+  void Printf(Args... args) {
+    if (dropping_) {
+      return;
+    }
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      size_t room = limit_ - size_;
+      int len = std::snprintf(buffer_ + size_, room + 1, Fmt.data, args...);
+      if (len < 0) {
+        return;
+      }
+      if (static_cast<size_t>(len) <= room) {
+        Commit(static_cast<size_t>(len));
+        return;
+      }
+      if (!Overflow()) {
+        return;
+      }
+    }
+    // 单行超过整个缓冲区：只能丢弃这一行
+    truncated_ = true;
+  }
+
+  /**
+   * @brief 追加原始字节
+   * @param data 数据地址
+   * @param size 数据长度
+   */
+  void Write(const char* data, size_t size) {
+    if (dropping_) {
+      return;
+    }
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      if (size <= limit_ - size_) {
+        std::memcpy(buffer_ + size_, data, size);
+        Commit(size);
+        return;
+      }
+      if (!Overflow()) {
+        return;
+      }
+    }
+    truncated_ = true;
+  }
+
+  /**
+   * @brief 结束当前帧并以单次写操作输出
+   */
+  void Flush() {
+    Seal();
+    Emit(buffer_, size_);
+    size_ = 0;
+    line_start_ = 0;
+    dropping_ = false;
+    truncated_ = false;
+  }
+
+  /**
+   * @brief 结束当前内容但不输出：截断过时在末尾补上截断标记
+   * @details 用于格式化到暂存区、稍后整体拷贝输出的场景；之后的写入均被丢弃。
+   *          缓冲区需大于 TRUNCATED_MARK_LEN + 1 字节。
+   */
+  void Seal() {
+    if (truncated_ && overflow_ == FrameOverflow::TRUNCATE) {
+      std::memcpy(buffer_ + size_, TRUNCATED_MARK, TRUNCATED_MARK_LEN);
+      size_ += TRUNCATED_MARK_LEN;
+      truncated_ = false;
+      dropping_ = true;
+    }
+  }
+
+  /**
+   * @brief prof 模式下把写操作耗时计入会话统计
+   * @param profile 耗时统计，为空时不计时
+   */
+  void Profile(MonitorProfile* profile) { profile_ = profile; }
+
+  /**
+   * @brief 当前帧是否发生过截断
+   */
+  bool Truncated() const { return truncated_; }
+
+  /**
+   * @brief 当前已缓存字节数
+   */
+  size_t Size() const { return size_; }
+
+  /**
+   * @brief 已缓存内容
+   */
+  const char* Data() const { return buffer_; }
+
+ private:
+  void Emit(const char* data, size_t size) {
+    if (profile_ == nullptr) {
+      write_bytes(data, size);
+      return;
+    }
+    const uint32_t begin = MonitorProfile::Now();
+    write_bytes(data, size);
+    profile_->Add(ProfileStage::WRITE, MonitorProfile::Now() - begin);
+  }
+
+  void Commit(size_t len) {
+    size_ += len;
+    if (len > 0 && buffer_[size_ - 1] == '\n') {
+      line_start_ = size_;
+    }
+  }
+
+  /**
+   * @brief 处理溢出
+   * @return bool 已腾出空间可以重试时返回 true
+   */
+  bool Overflow() {
+    if (overflow_ == FrameOverflow::CHUNK && size_ > 0) {
+      // 优先在行边界切分；整块都是同一行时只能原样输出
+      size_t cut = line_start_ > 0 ? line_start_ : size_;
+      Emit(buffer_, cut);
+      std::memmove(buffer_, buffer_ + cut, size_ - cut);
+      size_ -= cut;
+      line_start_ = 0;
+      return true;
+    }
+    if (overflow_ == FrameOverflow::TRUNCATE) {
+      size_ = line_start_;
+      dropping_ = true;
+    }
+    truncated_ = true;
+    return false;
+  }
+
+  char* buffer_;
+  MonitorProfile* profile_ = nullptr;
+  size_t limit_ = 0;
+  size_t size_ = 0;
+  size_t line_start_ = 0;
+  FrameOverflow overflow_;
+  bool dropping_ = false;
+  bool truncated_ = false;
+};
+
+/**
+ * @brief 自带定长存储的单帧格式化器
+ * @tparam Capacity 缓冲区大小
+ */
+template <size_t Capacity = DEBUG_CORE_FRAME_BUFFER_SIZE>
+class FrameBuffer : public FrameWriter {
+ public:
+  explicit FrameBuffer(FrameOverflow overflow =
+                           DEBUG_CORE_FRAME_OVERFLOW_CHUNK
+                               ? FrameOverflow::CHUNK
+                               : FrameOverflow::TRUNCATE)
+      : FrameWriter(storage_, Capacity, overflow) {}
+
+ private:
+  char storage_[Capacity];
+};
+
+inline void print_stats(const StatsAccumulator& stats) {
+  FrameBuffer<> out;
+  out.Printf<"[stats] samples=%u span=%u..%u ms\r\n">(
+      static_cast<unsigned>(stats.Samples()),
+      static_cast<unsigned>(stats.FirstMs()),
+      static_cast<unsigned>(stats.LastMs()));
+  const char* group = nullptr;
+  for (size_t i = 0; i < stats.FieldCount(); ++i) {
+    const auto& f = stats.Field(i);
+    if (f.group != nullptr && f.group != group) {
+      out.Printf<"-- %s\r\n">(f.group);
+    }
+    group = f.group;
+    out.Printf<"  %s: n=%u min=%.4f max=%.4f mean=%.4f std=%.4f\r\n">(
+        f.name, static_cast<unsigned>(f.count), static_cast<double>(f.min),
+        static_cast<double>(f.max), f.mean, f.Stddev());
+  }
+  if (stats.Overflow()) {
+    out.Printf<"  ...(more than %u fields)\r\n">(
+        static_cast<unsigned>(DEBUG_CORE_STATS_MAX_FIELDS));
+  }
+  out.Flush();
+}
+
+/**
+ * @brief 单个元素的字节数，CUSTOM 返回 0
+ * @details 数组字段的 type 为元素类型、size 为总字节数，元素个数即
+ *          size / field_type_size(type)。
+ */
+constexpr size_t field_type_size(FieldType type) {
+  switch (type) {
+    case FieldType::BOOL:
+    case FieldType::U8:
+    case FieldType::I8:
+      return 1;
+    case FieldType::I16:
+    case FieldType::U16:
+      return 2;
+    case FieldType::F32:
+    case FieldType::I32:
+    case FieldType::U32:
+      return 4;
+    case FieldType::I64:
+    case FieldType::U64:
+    case FieldType::F64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief 是否为浮点字段，决定 delta 死区与降采样 DEFAULT 的含义
+ */
+constexpr bool field_type_is_float(FieldType type) {
+  return type == FieldType::F32 || type == FieldType::F64;
+}
+
+/**
+ * @brief 字段打印函数：输出 `  name=value\r\n` 形式的一行或多行
+ */
+using FieldPrintFn = void (*)(FrameWriter& out, const char* name,
+                              const void* field_ptr);
+
+/// emit_field_value() 的最大输出长度
+inline constexpr size_t FIELD_VALUE_MAX =
+    F32_TEXT_MAX > INT_TEXT_MAX ? F32_TEXT_MAX : INT_TEXT_MAX;
+
+/**
+ * @brief 按类型标签把标量值写成文本（不含字段名与换行），返回长度
+ * @details 覆盖 BOOL、整数与 F32，输出与 print_typed_field() 一致；其余类型
+ *          返回 0。字段地址不要求对齐。
+ * @param precision F32 小数位数，负数表示默认 4 位
+ */
+inline size_t emit_field_value(char* out, FieldType type, int8_t precision,
+                               const void* value_ptr) {
+  auto load = [value_ptr](auto value) {
+    std::memcpy(&value, value_ptr, sizeof(value));
+    return value;
+  };
+  switch (type) {
+    case FieldType::BOOL: {
+      bool value = load(false);
+      std::memcpy(out, value ? "true" : "false", value ? 4 : 5);
+      return value ? 4 : 5;
+    }
+    case FieldType::U8:
+      return format_u64(out, load(uint8_t{}));
+    case FieldType::I8:
+      return format_i64(out, load(int8_t{}));
+    case FieldType::I16:
+      return format_i64(out, load(int16_t{}));
+    case FieldType::U16:
+      return format_u64(out, load(uint16_t{}));
+    case FieldType::I32:
+      return format_i64(out, load(int32_t{}));
+    case FieldType::U32:
+      return format_u64(out, load(uint32_t{}));
+    case FieldType::I64:
+      return format_i64(out, load(int64_t{}));
+    case FieldType::U64:
+      return format_u64(out, load(uint64_t{}));
+    case FieldType::F32:
+      return format_f32(out, load(0.0f),
+                        precision < 0 ? 4 : static_cast<uint8_t>(precision));
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief 输出 `  name=value` 一行
+ * @details 在栈上拼出整行后单次写入，不经过 printf；字段名过长时前缀单独写入。
+ */
+inline void print_field_line(FrameWriter& out, const char* name,
+                             FieldType type, int8_t precision,
+                             const void* value) {
+  constexpr size_t LINE_SIZE = 128;
+  char line[LINE_SIZE];
+  size_t name_len = std::strlen(name);
+  size_t len = 0;
+  if (name_len + FIELD_VALUE_MAX + 5 <= LINE_SIZE) {
+    line[0] = ' ';
+    line[1] = ' ';
+    std::memcpy(line + 2, name, name_len);
+    len = 2 + name_len;
+  } else {
+    out.Write("  ", 2);
+    out.Write(name, name_len);
+  }
+  line[len++] = '=';
+  len += emit_field_value(line + len, type, precision, value);
+  line[len++] = '\r';
+  line[len++] = '\n';
+  out.Write(line, len);
+}
+
+/**
+ * @brief Structured 模式字段描述
+ * @details 偏移与大小压缩为 16 位（快照不超过 64 KiB，字段宏在编译期检查），
+ *          BOOL、整数与 F32 标量不保存打印函数，打印时按类型标签分派到
+ *          emit_field_value()；只有枚举、数组、double 与自定义字段经 print
+ *          间接调用。成员按对齐从大到小排列，64 位下 32 字节、32 位下 24 字节
+ *          （32 个视图）。
+ */
+struct FieldDesc {
+  /**
+   * @brief 由字段宏调用，参数顺序与宏展开一致
+   * @param print 为空时按 type 分派到 emit_field_value()
+   * @param precision F32 小数位数，负数表示默认
+   */
+  constexpr FieldDesc(const char* name, uint16_t offset, ViewMask view_mask,
+                      FieldPrintFn print, FieldType type, uint16_t size,
+                      int8_t precision = -1, float deadband = 0.0f,
+                      Reduction reduce = Reduction::DEFAULT)
+      : name(name),
+        print(print),
+        view_mask(view_mask),
+        deadband(deadband),
+        offset(offset),
+        size(size),
+        type(type),
+        precision(precision),
+        reduce(reduce) {}
+
+  const char* name;
+  FieldPrintFn print;  ///< 为空时按类型标签打印
+  ViewMask view_mask;
+  float deadband;     ///< delta 模式下 F32 字段的死区
+  uint16_t offset;    ///< 字段在快照中的偏移
+  uint16_t size;      ///< 字段字节数
+  FieldType type;     ///< 字段类型，写入二进制 schema
+  int8_t precision;   ///< F32 小数位数，负数表示默认
+  Reduction reduce;   ///< 降采样时的规约方式
+};
+
+/**
+ * @brief 按视图选择遍历字段
+ * @details 包含默认（full）视图时遍历全部字段；单视图且提供了字段索引时只
+ *          访问该视图的字段下标列表；否则（多视图并集或无索引）逐字段测试视图
+ *          掩码，每个字段至多访问一次，顺序与字段表一致。
+ * @param index make_field_view_index() 生成的索引，可为空
+ * @param fn 回调，签名 void(const Desc& field, size_t field_index)
+ */
+template <typename Desc, typename Fn>
+inline void for_each_view_field(const Desc* fields, size_t field_count,
+                                const ViewSelection& selection,
+                                const FieldViewIndex& index, Fn&& fn) {
+  if (selection.full) {
+    for (size_t i = 0; i < field_count; ++i) {
+      fn(fields[i], i);
+    }
+    return;
+  }
+  if (!selection.multi && !index.Empty()) {
+    uint8_t view = selection.view;
+    if (view >= index.ViewCount()) {
+      return;
+    }
+    const uint16_t* end = index.Last(view);
+    for (const uint16_t* it = index.First(view); it != end; ++it) {
+      fn(fields[*it], *it);
+    }
+    return;
+  }
+  for (size_t i = 0; i < field_count; ++i) {
+    if (fields[i].view_mask.Intersects(selection.mask)) {
+      fn(fields[i], i);
+    }
+  }
+}
+
+namespace detail {
+
+template <typename T>
+inline double load_field_scalar(const void* value_ptr) {
+  T value{};
+  std::memcpy(&value, value_ptr, sizeof(value));
+  return static_cast<double>(value);
+}
+
+template <typename T>
+inline void store_field_integer(void* value_ptr, double value) {
+  constexpr double LOW = static_cast<double>(std::numeric_limits<T>::min());
+  constexpr double HIGH = static_cast<double>(std::numeric_limits<T>::max());
+  double rounded = std::floor(value + 0.5);
+  T result = rounded <= LOW    ? std::numeric_limits<T>::min()
+             : rounded >= HIGH ? std::numeric_limits<T>::max()
+                               : static_cast<T>(rounded);
+  std::memcpy(value_ptr, &result, sizeof(result));
+}
+
+}  // namespace detail
+
+/**
+ * @brief 按字段类型读取数值
+ * @param size 字段字节数，与元素宽度不符（数组字段）时不读取，0 表示未知
+ * @return bool CUSTOM 与数组字段返回 false
+ */
+inline bool read_field_value(FieldType type, size_t size, const void* value_ptr,
+                             double* out) {
+  if (size != 0 && size != field_type_size(type)) {
+    return false;
+  }
+  switch (type) {
+    case FieldType::BOOL: {
+      bool value = false;
+      std::memcpy(&value, value_ptr, sizeof(value));
+      *out = value ? 1.0 : 0.0;
+      return true;
+    }
+    case FieldType::U8:
+      *out = *static_cast<const uint8_t*>(value_ptr);
+      return true;
+    case FieldType::F32:
+      *out = detail::load_field_scalar<float>(value_ptr);
+      return true;
+    case FieldType::I8:
+      *out = detail::load_field_scalar<int8_t>(value_ptr);
+      return true;
+    case FieldType::I16:
+      *out = detail::load_field_scalar<int16_t>(value_ptr);
+      return true;
+    case FieldType::U16:
+      *out = detail::load_field_scalar<uint16_t>(value_ptr);
+      return true;
+    case FieldType::I32:
+      *out = detail::load_field_scalar<int32_t>(value_ptr);
+      return true;
+    case FieldType::U32:
+      *out = detail::load_field_scalar<uint32_t>(value_ptr);
+      return true;
+    case FieldType::I64:
+      *out = detail::load_field_scalar<int64_t>(value_ptr);
+      return true;
+    case FieldType::U64:
+      *out = detail::load_field_scalar<uint64_t>(value_ptr);
+      return true;
+    case FieldType::F64:
+      *out = detail::load_field_scalar<double>(value_ptr);
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief 按字段类型写回数值，整数与布尔字段四舍五入并饱和到类型范围
+ */
+inline void write_field_value(FieldType type, void* value_ptr, double value) {
+  switch (type) {
+    case FieldType::BOOL: {
+      bool flag = value >= 0.5;
+      std::memcpy(value_ptr, &flag, sizeof(flag));
+      break;
+    }
+    case FieldType::U8:
+      detail::store_field_integer<uint8_t>(value_ptr, value);
+      break;
+    case FieldType::F32: {
+      float f = static_cast<float>(value);
+      std::memcpy(value_ptr, &f, sizeof(f));
+      break;
+    }
+    case FieldType::I8:
+      detail::store_field_integer<int8_t>(value_ptr, value);
+      break;
+    case FieldType::I16:
+      detail::store_field_integer<int16_t>(value_ptr, value);
+      break;
+    case FieldType::U16:
+      detail::store_field_integer<uint16_t>(value_ptr, value);
+      break;
+    case FieldType::I32:
+      detail::store_field_integer<int32_t>(value_ptr, value);
+      break;
+    case FieldType::U32:
+      detail::store_field_integer<uint32_t>(value_ptr, value);
+      break;
+    case FieldType::I64:
+      detail::store_field_integer<int64_t>(value_ptr, value);
+      break;
+    case FieldType::U64:
+      detail::store_field_integer<uint64_t>(value_ptr, value);
+      break;
+    case FieldType::F64:
+      std::memcpy(value_ptr, &value, sizeof(value));
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief 按字段类型把数值累计到 stats，CUSTOM 字段忽略
+ * @param group 所属模块，单模块会话为空
+ */
+inline void accumulate_field(StatsAccumulator& stats, const char* group,
+                             const char* name, FieldType type, size_t size,
+                             const void* value_ptr) {
+  double value = 0.0;
+  if (read_field_value(type, size, value_ptr, &value)) {
+    stats.Add(group, name, value);
+  }
+}
+
+/**
+ * @brief 按视图选择累计 Structured 快照字段
+ */
+inline void accumulate_structured_fields(StatsAccumulator& stats,
+                                         const char* group,
+                                         const FieldDesc* fields,
+                                         size_t field_count,
+                                         const uint8_t* base,
+                                         const ViewSelection& selection,
+                                         const FieldViewIndex& index = {}) {
+  for_each_view_field(fields, field_count, selection, index,
+                      [&](const FieldDesc& f, size_t) {
+                        accumulate_field(stats, group, f.name, f.type,
+                                         f.size, base + f.offset);
+                      });
+}
+
+/**
+ * @brief 降采样：按视图选择累计一次 Structured 快照采集
+ */
+inline void reduce_add_structured(Reducer& reducer, const FieldDesc* fields,
+                                  size_t field_count, const uint8_t* base,
+                                  const ViewSelection& selection,
+                                  const FieldViewIndex& index = {}) {
+  for_each_view_field(fields, field_count, selection, index,
+                      [&](const FieldDesc& f, size_t) {
+                        double value = 0.0;
+                        if (read_field_value(f.type, f.size, base + f.offset,
+                                             &value)) {
+                          reducer.Add(value);
+                        }
+                      });
+}
+
+/**
+ * @brief 降采样：把本周期的规约值写回快照（即最后一次采集）
+ */
+inline void reduce_take_structured(Reducer& reducer, const FieldDesc* fields,
+                                   size_t field_count, uint8_t* base,
+                                   const ViewSelection& selection,
+                                   const FieldViewIndex& index = {}) {
+  for_each_view_field(
+      fields, field_count, selection, index, [&](const FieldDesc& f, size_t) {
+        double value = 0.0;
+        if (!read_field_value(f.type, f.size, base + f.offset, &value)) {
+          return;
+        }
+        double result =
+            reducer.Take(f.reduce, field_type_is_float(f.type), value);
+        // 结果即最后一次采集时原样保留，避免 64 位整数经 double 往返丢精度
+        if (result != value) {
+          write_field_value(f.type, base + f.offset, result);
+        }
+      });
+}
+
+/**
+ * @brief 触发条件
+ */
+enum class TriggerOp : uint8_t {
+  GT,    ///< 电平：value > threshold
+  GE,    ///< 电平：value >= threshold
+  LT,    ///< 电平：value < threshold
+  LE,    ///< 电平：value <= threshold
+  EQ,    ///< 电平：value == threshold
+  NE,    ///< 电平：value != threshold
+  RISE,  ///< 上升沿：上一采样 < threshold 且本采样 >= threshold
+  FALL,  ///< 下降沿：上一采样 > threshold 且本采样 <= threshold
+};
+
+/**
+ * @brief 触发状态
+ */
+enum class TriggerState : uint8_t {
+  IDLE,       ///< 未布防，正常录制
+  ARMED,      ///< 已布防，等待条件成立
+  TRIGGERED,  ///< 条件已成立，正在录制触发后采样
+  CAPTURED,   ///< 捕获完成，录制保持冻结直到重新布防或关闭
+};
+
+/**
+ * @brief 触发配置
+ */
+struct TriggerConfig {
+  size_t offset;      ///< 被监视字段在快照中的偏移
+  FieldType type;     ///< 标量数值类型，不支持 CUSTOM 与数组
+  TriggerOp op;
+  float threshold;
+  uint16_t pre;       ///< 触发前保留的采样数
+  uint16_t post;      ///< 触发后继续录制的采样数
+};
+
+/**
+ * @brief 把字段值读取为 float，供触发比较
+ */
+inline float read_trigger_value(const uint8_t* base, const TriggerConfig& cfg) {
+  double value = 0.0;
+  read_field_value(cfg.type, field_type_size(cfg.type), base + cfg.offset,
+                   &value);
+  return static_cast<float>(value);
+}
+
+/**
+ * @brief 判断触发条件
+ * @param prev 上一采样值，has_prev 为 false 时边沿触发不成立
+ */
+inline bool evaluate_trigger(TriggerOp op, float threshold, float prev,
+                             bool has_prev, float value) {
+  switch (op) {
+    case TriggerOp::GT:
+      return value > threshold;
+    case TriggerOp::GE:
+      return value >= threshold;
+    case TriggerOp::LT:
+      return value < threshold;
+    case TriggerOp::LE:
+      return value <= threshold;
+    case TriggerOp::EQ:
+      return value == threshold;
+    case TriggerOp::NE:
+      return value != threshold;
+    case TriggerOp::RISE:
+      return has_prev && prev < threshold && value >= threshold;
+    case TriggerOp::FALL:
+      return has_prev && prev > threshold && value <= threshold;
+  }
+  return false;
+}
+
+/**
+ * @brief 快照飞行记录器（与快照类型、容量无关的公共部分）
+ * @details 控制循环每个周期调用 Record() 把快照写入环形缓冲区，开销为一次时间
+ *          读取、一次快照拷贝和几次原子读写，从不阻塞。读取时先冻结录制并等待
+ *          正在进行的 Record() 结束，读完后恢复录制；冻结期间的 Record() 直接
+ *          返回。
+ *
+ *          布防触发后，Record() 在写入每条记录时检查条件；条件成立且已有 pre
+ *          条触发前记录时，再录制 post 条后进入 CAPTURED 并停止覆盖，保留
+ *          [触发前 pre 条, 触发点, 触发后 post 条] 窗口供 dump 输出。
+ *
+ *          快照按字节存放，dump / trigger 命令只依赖本类，不随快照类型实例化。
+ */
+class SnapshotRecorderBase {
+ public:
+  SnapshotRecorderBase(const SnapshotRecorderBase&) = delete;
+  SnapshotRecorderBase& operator=(const SnapshotRecorderBase&) = delete;
+
+  /**
+   * @brief 环形缓冲区容量
+   */
+  size_t Capacity() const { return mask_ + 1; }
+
+  /**
+   * @brief 单条快照字节数
+   */
+  size_t SnapshotSize() const { return snapshot_size_; }
+
+  /**
+   * @brief 布防触发，丢弃上一次捕获
+   * @return bool pre + post + 1 超过容量时返回 false
+   */
+  bool Arm(const TriggerConfig& config) {
+    if (static_cast<size_t>(config.pre) + config.post + 1 > Capacity()) {
+      return false;
+    }
+    LibXR::Mutex::LockGuard lock_guard(reader_mutex_);
+    StopTrigger();
+    trigger_ = config;
+    trigger_count_ = 0;
+    trigger_has_prev_ = false;
+    trigger_remaining_ = config.post;
+    trigger_state_.store(TriggerState::ARMED);
+    return true;
+  }
+
+  /**
+   * @brief 撤防并恢复正常录制
+   */
+  void Disarm() {
+    LibXR::Mutex::LockGuard lock_guard(reader_mutex_);
+    StopTrigger();
+  }
+
+  /**
+   * @brief 当前触发状态
+   */
+  TriggerState GetTriggerState() const { return trigger_state_.load(); }
+
+  /**
+   * @brief 冻结录制，按时间顺序遍历最近 count 条记录后恢复录制
+   * @param count 条数，0 时取全部；捕获完成时 0 表示整个触发窗口
+   * @param fn 回调，签名 void(uint32_t timestamp_ms, const uint8_t* snapshot,
+   *           bool is_trigger)
+   * @return size_t 实际遍历条数
+   */
+  template <typename Fn>
+  size_t Dump(size_t count, Fn fn) {
+    LibXR::Mutex::LockGuard lock_guard(reader_mutex_);
+    frozen_.store(true);
+    while (busy_.load()) {
+      LibXR::Thread::Sleep(1);
+    }
+
+    uint32_t head = head_.load(std::memory_order_acquire);
+    size_t available = head < Capacity() ? head : Capacity();
+    const bool captured = trigger_state_.load() == TriggerState::CAPTURED;
+    if (count == 0 && captured) {
+      count = static_cast<size_t>(trigger_.pre) + trigger_.post + 1;
+    }
+    if (count == 0 || count > available) {
+      count = available;
+    }
+    for (uint32_t k = head - static_cast<uint32_t>(count); k != head; ++k) {
+      fn(timestamps_[k & mask_],
+         static_cast<const uint8_t*>(snapshots_ + (k & mask_) * snapshot_size_),
+         captured && k == trigger_index_);
+    }
+
+    frozen_.store(false);
+    return count;
+  }
+
+ protected:
+  SnapshotRecorderBase(uint32_t* timestamps, uint8_t* snapshots,
+                       size_t snapshot_size, size_t capacity)
+      : timestamps_(timestamps),
+        snapshots_(snapshots),
+        snapshot_size_(snapshot_size),
+        mask_(static_cast<uint32_t>(capacity - 1)) {}
+
+  /**
+   * @brief 开始记录一条快照
+   * @return uint8_t* 本条快照的存放位置，录制冻结或捕获完成时为空
+   */
+  uint8_t* BeginRecord(uint32_t timestamp_ms) {
+    busy_.store(true);
+    record_state_ = trigger_state_.load();
+    if (frozen_.load() || record_state_ == TriggerState::CAPTURED) {
+      return nullptr;
+    }
+    uint32_t slot = head_.load(std::memory_order_relaxed) & mask_;
+    timestamps_[slot] = timestamp_ms;
+    return snapshots_ + slot * snapshot_size_;
+  }
+
+  /**
+   * @brief 结束记录，slot 为 BeginRecord() 的返回值
+   */
+  void EndRecord(const uint8_t* slot) {
+    if (slot != nullptr) {
+      uint32_t head = head_.load(std::memory_order_relaxed);
+      if (record_state_ == TriggerState::ARMED) {
+        CheckTrigger(slot, head);
+      } else if (record_state_ == TriggerState::TRIGGERED &&
+                 --trigger_remaining_ == 0) {
+        trigger_state_.store(TriggerState::CAPTURED,
+                             std::memory_order_release);
+      }
+      head_.store(head + 1, std::memory_order_release);
+    }
+    busy_.store(false);
+  }
+
+ private:
+  void CheckTrigger(const uint8_t* base, uint32_t head) {
+    float value = read_trigger_value(base, trigger_);
+    bool fired = trigger_count_ >= trigger_.pre &&
+                 evaluate_trigger(trigger_.op, trigger_.threshold,
+                                  trigger_prev_, trigger_has_prev_, value);
+    trigger_prev_ = value;
+    trigger_has_prev_ = true;
+    if (trigger_count_ < trigger_.pre) {
+      ++trigger_count_;
+    }
+    if (!fired) {
+      return;
+    }
+    trigger_index_ = head;
+    trigger_state_.store(trigger_.post == 0 ? TriggerState::CAPTURED
+                                            : TriggerState::TRIGGERED,
+                         std::memory_order_release);
+  }
+
+  /// 调用方持有 reader_mutex_；返回后控制循环不再访问触发配置
+  void StopTrigger() {
+    trigger_state_.store(TriggerState::IDLE);
+    while (busy_.load()) {
+      LibXR::Thread::Sleep(1);
+    }
+  }
+
+  uint32_t* timestamps_;
+  uint8_t* snapshots_;
+  size_t snapshot_size_;
+  uint32_t mask_;
+  std::atomic<uint32_t> head_{0};  ///< 累计写入条数，仅控制循环写
+  std::atomic<bool> busy_{false};
+  std::atomic<bool> frozen_{false};
+  std::atomic<TriggerState> trigger_state_{TriggerState::IDLE};
+  TriggerState record_state_ = TriggerState::IDLE;  ///< 仅控制循环访问
+  TriggerConfig trigger_{};
+  uint32_t trigger_index_ = 0;       ///< 触发点的累计写入序号
+  uint16_t trigger_count_ = 0;       ///< 布防后已录制条数，饱和于 pre
+  uint16_t trigger_remaining_ = 0;   ///< 触发后剩余录制条数
+  float trigger_prev_ = 0.0f;
+  bool trigger_has_prev_ = false;
+  LibXR::Mutex reader_mutex_;
+};
+
+/**
+ * @brief 快照飞行记录器（与容量无关的公共部分）
+ * @details 只提供按类型记录的接口，快照拷贝按编译期大小内联。
+ * @tparam Snapshot 快照类型，需可平凡拷贝
+ */
+template <typename Snapshot>
+class SnapshotRecorder : public SnapshotRecorderBase {
+  static_assert(std::is_trivially_copyable_v<Snapshot>,
+                "Snapshot must be trivially copyable");
+
+ public:
+  /**
+   * @brief 以当前时间记录一条快照，仅限控制循环线程
+   */
+  void Record(const Snapshot& snapshot) {
+    Record(snapshot, static_cast<uint32_t>(LibXR::Thread::GetTime()));
+  }
+
+  /**
+   * @brief 以指定时间记录一条快照，仅限控制循环线程
+   */
+  void Record(const Snapshot& snapshot, uint32_t timestamp_ms) {
+    uint8_t* slot = BeginRecord(timestamp_ms);
+    if (slot != nullptr) {
+      std::memcpy(slot, &snapshot, sizeof(Snapshot));
+    }
+    EndRecord(slot);
+  }
+
+ protected:
+  SnapshotRecorder(uint32_t* timestamps, Snapshot* snapshots, size_t capacity)
+      : SnapshotRecorderBase(timestamps, reinterpret_cast<uint8_t*>(snapshots),
+                             sizeof(Snapshot), capacity) {}
+};
+
+/**
+ * @brief 固定容量的快照飞行记录器
+ * @tparam Snapshot 快照类型
+ * @tparam N 记录条数，需为 2 的幂
+ */
+template <typename Snapshot, size_t N>
+class FlightRecorder : public SnapshotRecorder<Snapshot> {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+
+ public:
+  FlightRecorder() : SnapshotRecorder<Snapshot>(timestamps_, snapshots_, N) {}
+
+ private:
+  uint32_t timestamps_[N]{};
+  Snapshot snapshots_[N]{};
+};
+
+struct StructuredProviderBase;
+
+/**
+ * @brief Structured 提供器中与快照类型相关的操作
+ * @details 每个快照类型一份常量表，由 StructuredProvider<Snapshot> 生成；命令
+ *          执行器与注册表只通过它接触快照类型，其余逻辑只实例化一次。
+ */
+struct StructuredOps {
+  size_t snapshot_size;
+  /// 在 out 处值初始化一份快照并抓取
+  void (*capture)(const StructuredProviderBase& provider, void* self,
+                  void* out);
+  /// 模块的飞行记录器，未提供时为空
+  SnapshotRecorderBase* (*recorder)(const StructuredProviderBase& provider,
+                                    void* self);
+  /// 在栈上分配快照存储和配套的二进制帧缓冲区后调用 fn
+  void (*with_buffers)(void (*fn)(void* ctx, uint8_t* snapshot,
+                                  BinaryFrame& frame),
+                       void* ctx);
+};
+
+/**
+ * @brief Structured 模式提供器（与快照类型无关的部分）
+ */
+struct StructuredProviderBase {
+  const char* module_name;
+  const char* view_help;
+  bool (*parse_view)(const char* arg, uint8_t* out_view);
+  const char* (*view_to_string)(uint8_t view);
+  const FieldDesc* fields;
+  size_t field_count;
+  /// 可选：make_field_view_index() 生成的按视图字段索引
+  FieldViewIndex field_index;
+  /// 可选：make_name_pool() 生成的共享名称池，二进制 schema 据此发送名称编号
+  NamePool names;
+  const StructuredOps* ops;
+};
+
+/**
+ * @brief Structured 模式提供器
+ * @details 构造参数依次为模块名、视图帮助、视图解析与显示回调、抓取回调、
+ *          字段表与字段数，以及可选的飞行记录器回调、按视图字段索引和共享
+ *          名称池。
+ * @tparam Snapshot 快照类型
+ */
+template <typename Snapshot>
+struct StructuredProvider : StructuredProviderBase {
+  using CaptureFn = void (*)(void* self, Snapshot* out_snapshot);
+  /// 返回模块的飞行记录器，启用 dump 命令
+  using RecorderFn = SnapshotRecorder<Snapshot>* (*)(void* self);
+
+  constexpr StructuredProvider(
+      const char* module_name, const char* view_help,
+      bool (*parse_view)(const char* arg, uint8_t* out_view),
+      const char* (*view_to_string)(uint8_t view), CaptureFn capture,
+      const FieldDesc* fields, size_t field_count,
+      RecorderFn recorder = nullptr, FieldViewIndex field_index = {},
+      NamePool names = {})
+      : StructuredProviderBase{module_name, view_help, parse_view,
+                               view_to_string, fields, field_count,
+                               field_index, names, &OPS},
+        capture(capture),
+        recorder(recorder) {}
+
+  CaptureFn capture;
+  RecorderFn recorder;
+
+  static const StructuredOps OPS;
+
+ private:
+  static const StructuredProvider& Self(const StructuredProviderBase& base) {
+    return static_cast<const StructuredProvider&>(base);
+  }
+
+  static void Capture(const StructuredProviderBase& base, void* self,
+                      void* out) {
+    static_assert(std::is_trivially_copyable_v<Snapshot>,
+                  "Snapshot must be trivially copyable");
+    Self(base).capture(self, new (out) Snapshot{});
+  }
+
+  static SnapshotRecorderBase* Recorder(const StructuredProviderBase& base,
+                                        void* self) {
+    return Self(base).recorder ? Self(base).recorder(self) : nullptr;
+  }
+
+  static void WithBuffers(void (*fn)(void* ctx, uint8_t* snapshot,
+                                     BinaryFrame& frame),
+                          void* ctx) {
+    alignas(Snapshot) uint8_t snapshot[sizeof(Snapshot)];
+    BinaryFrameBuffer<sizeof(Snapshot) + ViewMask::BYTES + 12> frame;
+    fn(ctx, snapshot, frame);
+  }
+};
+
+template <typename Snapshot>
+const StructuredOps StructuredProvider<Snapshot>::OPS = {
+    sizeof(Snapshot), &StructuredProvider::Capture,
+    &StructuredProvider::Recorder, &StructuredProvider::WithBuffers};
+
+/**
+ * @brief 解析 Structured 提供器的视图选择 `view[+view...]`
+ */
+inline bool parse_structured_selection(const StructuredProviderBase& provider,
+                                       const char* arg, uint8_t default_view,
+                                       ViewSelection* out) {
+  return provider.parse_view != nullptr &&
+         parse_view_selection(arg, default_view, provider.parse_view, out);
+}
+
+/**
+ * @brief Structured 提供器视图选择的显示名
+ */
+inline const char* structured_selection_name(
+    const StructuredProviderBase& provider, const ViewSelection& selection,
+    char* buf, size_t size) {
+  return view_selection_name(
+      selection,
+      [&](uint8_t v) {
+        return provider.view_to_string ? provider.view_to_string(v)
+                                       : "unknown";
+      },
+      buf, size);
+}
+
+/**
+ * @brief 控制循环发布、调试线程读取的快照通道
+ * @details 三缓冲：生产者（控制循环）始终写自己独占的后台缓冲区，发布时用一次
+ *          原子交换把它换成“最新”缓冲区，从不等待也不重试；读者用一次原子交换
+ *          取走最新缓冲区后拷贝，不会与生产者产生撕裂。多个读者（终端、后台
+ *          任务、合并采样器）之间用互斥锁串行化，读者之间的等待不会影响生产者。
+ * @tparam Snapshot 快照类型，需可平凡拷贝
+ */
+template <typename Snapshot>
+class SnapshotChannel {
+  static_assert(std::is_trivially_copyable_v<Snapshot>,
+                "Snapshot must be trivially copyable");
+
+ public:
+  /**
+   * @brief 获取后台缓冲区，仅限生产者线程，填好后调用 Commit()
+   */
+  Snapshot& Begin() { return buffers_[back_]; }
+
+  /**
+   * @brief 发布 Begin() 返回的缓冲区，仅限生产者线程
+   */
+  void Commit() {
+    uint32_t previous =
+        latest_.exchange(back_ | FRESH_BIT, std::memory_order_acq_rel);
+    back_ = static_cast<uint8_t>(previous & INDEX_MASK);
+  }
+
+  /**
+   * @brief 拷贝并发布一份快照，仅限生产者线程
+   */
+  void Publish(const Snapshot& snapshot) {
+    Begin() = snapshot;
+    Commit();
+  }
+
+  /**
+   * @brief 读取最近一次发布的完整快照
+   * @param out 输出快照
+   * @return bool 尚未发布过时返回 false，out 保持不变
+   */
+  bool Read(Snapshot* out) {
+    LibXR::Mutex::LockGuard lock_guard(reader_mutex_);
+    if (latest_.load(std::memory_order_acquire) & FRESH_BIT) {
+      front_ = static_cast<uint8_t>(
+          latest_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK);
+      has_data_ = true;
+    }
+    if (!has_data_) {
+      return false;
+    }
+    *out = buffers_[front_];
+    return true;
+  }
+
+ private:
+  static constexpr uint32_t INDEX_MASK = 0x3u;
+  static constexpr uint32_t FRESH_BIT = 0x4u;
+
+  Snapshot buffers_[3]{};
+  std::atomic<uint32_t> latest_{1};
+  uint8_t back_ = 0;   ///< 生产者独占
+  uint8_t front_ = 2;  ///< 读者独占
+  bool has_data_ = false;
+  LibXR::Mutex reader_mutex_;
+};
+
+/**
+ * @brief 从模块成员 SnapshotChannel 读取快照，可直接用作
+ *        StructuredProvider::capture
+ * @tparam Owner 模块类型
+ * @tparam Snapshot 快照类型
+ * @tparam Channel 模块中的通道成员
+ */
+template <typename Owner, typename Snapshot,
+          SnapshotChannel<Snapshot> Owner::*Channel>
+void capture_from_channel(void* self, Snapshot* out_snapshot) {
+  (static_cast<Owner*>(self)->*Channel).Read(out_snapshot);
+}
+
+/**
+ * @brief 输出 `  name=<float>` 一行，数值经 format_f32() 格式化，不经过 printf
+ * @param precision 小数位数，0~6
+ */
+inline void print_f32_line(FrameWriter& out, const char* name, float value,
+                           uint8_t precision) {
+  char text[F32_TEXT_MAX + 3];
+  text[0] = '=';
+  size_t len = 1 + format_f32(text + 1, value, precision);
+  text[len++] = '\r';
+  text[len++] = '\n';
+  out.Write("  ", 2);
+  out.Write(name, std::strlen(name));
+  out.Write(text, len);
+}
+
+/**
+ * @brief 打印布尔字段值
+ */
+inline void print_bool_field(FrameWriter& out, const char* name,
+                             const void* field_ptr) {
+  bool value = *reinterpret_cast<const bool*>(field_ptr);
+  out.Printf<"  %s=%s\r\n">(name, value ? "true" : "false");
+}
+
+/**
+ * @brief 打印 uint8 字段值
+ */
+inline void print_u8_field(FrameWriter& out, const char* name,
+                           const void* field_ptr) {
+  uint8_t value = *reinterpret_cast<const uint8_t*>(field_ptr);
+  out.Printf<"  %s=%u\r\n">(name, static_cast<unsigned>(value));
+}
+
+/**
+ * @brief 打印 float 字段值
+ */
+inline void print_f32_field(FrameWriter& out, const char* name,
+                            const void* field_ptr) {
+  float value = 0.0f;
+  std::memcpy(&value, field_ptr, sizeof(value));
+  print_f32_line(out, name, value, 4);
+}
+
+/**
+ * @brief 打印布尔值
+ */
+inline void print_bool_value(FrameWriter& out, const char* name, bool value) {
+  out.Printf<"  %s=%s\r\n">(name, value ? "true" : "false");
+}
+
+/**
+ * @brief 打印 uint8 值
+ */
+inline void print_u8_value(FrameWriter& out, const char* name,
+                           uint8_t value) {
+  out.Printf<"  %s=%u\r\n">(name, static_cast<unsigned>(value));
+}
+
+/**
+ * @brief 打印 float 值
+ */
+inline void print_f32_value(FrameWriter& out, const char* name, float value) {
+  print_f32_line(out, name, value, 4);
+}
+
+/**
+ * @brief 字段类型推导
+ * @details 标量（算术类型与枚举）的 COUNT 为 1；C 数组与 std::array 展开为
+ *          元素类型 Element 与元素个数 COUNT，多维数组按行优先展平。
+ *          TYPE 为元素的 FieldType，枚举取其底层整数类型。
+ */
+template <typename T>
+struct FieldTraits {
+  static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                "DEBUG_CORE_FIELD: unsupported member type, use "
+                "DEBUG_CORE_FIELD_CUSTOM");
+  static_assert(!std::is_floating_point_v<T> || sizeof(T) <= sizeof(double),
+                "DEBUG_CORE_FIELD: long double is not supported");
+
+  using Element = T;
+  static constexpr size_t COUNT = 1;
+
+  static constexpr FieldType Type() {
+    if constexpr (std::is_enum_v<T>) {
+      return FieldTraits<std::underlying_type_t<T>>::TYPE;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      return FieldType::BOOL;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      return sizeof(T) == sizeof(float) ? FieldType::F32 : FieldType::F64;
+    } else if constexpr (std::is_signed_v<T>) {
+      return sizeof(T) == 1   ? FieldType::I8
+             : sizeof(T) == 2 ? FieldType::I16
+             : sizeof(T) == 4 ? FieldType::I32
+                              : FieldType::I64;
+    } else {
+      return sizeof(T) == 1   ? FieldType::U8
+             : sizeof(T) == 2 ? FieldType::U16
+             : sizeof(T) == 4 ? FieldType::U32
+                              : FieldType::U64;
+    }
+  }
+
+  static constexpr FieldType TYPE = Type();
+};
+
+template <typename T, size_t N>
+struct FieldTraits<T[N]> {
+  using Element = typename FieldTraits<T>::Element;
+  static constexpr size_t COUNT = N * FieldTraits<T>::COUNT;
+  static constexpr FieldType TYPE = FieldTraits<T>::TYPE;
+};
+
+template <typename T, size_t N>
+struct FieldTraits<std::array<T, N>> {
+  using Element = typename FieldTraits<T>::Element;
+  static constexpr size_t COUNT = N * FieldTraits<T>::COUNT;
+  static constexpr FieldType TYPE = FieldTraits<T>::TYPE;
+};
+
+namespace detail {
+
+/**
+ * @brief 编译期拼接三段格式字符串
+ */
+template <size_t A, size_t B, size_t C>
+consteval FormatString<A + B + C - 2> join_format(const FormatString<A>& a,
+                                                  const FormatString<B>& b,
+                                                  const FormatString<C>& c) {
+  char buffer[A + B + C - 2] = {};
+  size_t pos = 0;
+  for (size_t i = 0; i + 1 < A; ++i) {
+    buffer[pos++] = a.data[i];
+  }
+  for (size_t i = 0; i + 1 < B; ++i) {
+    buffer[pos++] = b.data[i];
+  }
+  for (size_t i = 0; i < C; ++i) {
+    buffer[pos++] = c.data[i];
+  }
+  return FormatString<A + B + C - 2>(buffer);
+}
+
+/**
+ * @brief 查找枚举值的名称，未提供名称表或未命中返回 nullptr
+ */
+template <typename E>
+inline const char* enum_name(E value) {
+  if constexpr (requires { debug_core_enum_names(E{}); }) {
+    static constexpr auto NAMES = debug_core_enum_names(E{});
+    for (const auto& item : NAMES) {
+      if (item.value == value) {
+        return item.name;
+      }
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief 以 Pre + 值 + Post 的单次 Printf 输出一个标量
+ * @details 转换说明符在编译期按类型选定，打印循环中没有运行期类型分派；
+ *          float 走 format_f32()，不经过 printf。
+ * @tparam Precision 浮点小数位数，负数表示默认（float 4 位，double 6 位）
+ * @param text Pre 中 %s 对应的文本（字段名或数组分隔符）
+ */
+template <FormatString Pre, FormatString Post, int Precision = -1,
+          typename T>
+inline void print_scalar(FrameWriter& out, const char* text, T value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    out.Printf<join_format(Pre, FormatString("%s"), Post)>(
+        text, value ? "true" : "false");
+  } else if constexpr (std::is_enum_v<T>) {
+    const char* name = enum_name(value);
+    if (name != nullptr) {
+      out.Printf<join_format(Pre, FormatString("%s"), Post)>(text, name);
+    } else {
+      print_scalar<Pre, Post>(out, text,
+                              static_cast<std::underlying_type_t<T>>(value));
+    }
+  } else if constexpr (std::is_same_v<T, float>) {
+    constexpr uint8_t DIGITS = Precision < 0 ? 4 : Precision;
+    if constexpr (Post.data[0] != '\0') {
+      print_f32_line(out, text, value, DIGITS);
+    } else {
+      char number[F32_TEXT_MAX];
+      size_t len = format_f32(number, value, DIGITS);
+      out.Write(text, std::strlen(text));
+      out.Write(number, len);
+    }
+  } else if constexpr (std::is_floating_point_v<T>) {
+    constexpr int DIGITS = Precision < 0 ? 6 : Precision;
+    out.Printf<join_format(Pre, FormatString("%.*f"), Post)>(
+        text, DIGITS, static_cast<double>(value));
+  } else if constexpr (std::is_signed_v<T>) {
+    if constexpr (sizeof(T) <= sizeof(long)) {
+      out.Printf<join_format(Pre, FormatString("%ld"), Post)>(
+          text, static_cast<long>(value));
+    } else {
+      out.Printf<join_format(Pre, FormatString("%lld"), Post)>(
+          text, static_cast<long long>(value));
+    }
+  } else {
+    if constexpr (sizeof(T) <= sizeof(unsigned long)) {
+      out.Printf<join_format(Pre, FormatString("%lu"), Post)>(
+          text, static_cast<unsigned long>(value));
+    } else {
+      out.Printf<join_format(Pre, FormatString("%llu"), Post)>(
+          text, static_cast<unsigned long long>(value));
+    }
+  }
+}
+
+/**
+ * @brief Live 类型化字段：把表达式结果按 T 写入值缓冲区，数组整体拷贝
+ */
+template <typename T, typename Value>
+inline void store_live_value(void* out, const Value& value) {
+  if constexpr (std::is_array_v<T>) {
+    static_assert(sizeof(Value) == sizeof(T));
+    std::memcpy(out, &value, sizeof(T));
+  } else {
+    T converted = static_cast<T>(value);
+    std::memcpy(out, &converted, sizeof(converted));
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief 按推导类型打印字段
+ * @details 标量输出 `  name=value`，数组输出 `  name=[v0, v1, ...]`；
+ *          字段地址不要求对齐。
+ * @tparam T 字段类型，见 FieldTraits
+ * @tparam Precision 浮点小数位数（0~6），负数表示默认
+ */
+template <typename T, int Precision = -1>
+inline void print_typed_field(FrameWriter& out, const char* name,
+                              const void* field_ptr) {
+  static_assert(Precision <= static_cast<int>(F32_MAX_PRECISION),
+                "DEBUG_CORE_*_PREC: precision must be 0~6");
+  using Element = typename FieldTraits<T>::Element;
+  constexpr size_t COUNT = FieldTraits<T>::COUNT;
+  const auto* bytes = static_cast<const uint8_t*>(field_ptr);
+  if constexpr (COUNT == 1) {
+    Element value{};
+    std::memcpy(&value, bytes, sizeof(value));
+    detail::print_scalar<"  %s=", "\r\n", Precision>(out, name, value);
+  } else {
+    out.Printf<"  %s=[">(name);
+    for (size_t i = 0; i < COUNT; ++i) {
+      Element value{};
+      std::memcpy(&value, bytes + i * sizeof(Element), sizeof(value));
+      detail::print_scalar<"%s", "", Precision>(out, i == 0 ? "" : ", ",
+                                                value);
+    }
+    out.Write("]\r\n", 3);
+  }
+}
+
+/**
+ * @brief 按字段类型在编译期选定打印函数
+ * @details bool、整数与 float 标量返回空，打印时按类型标签分派；枚举（按名称
+ *          打印）、数组与 double 返回 print_typed_field()。
+ */
+template <typename T, int Precision = -1>
+constexpr FieldPrintFn field_printer() {
+  static_assert(Precision <= static_cast<int>(F32_MAX_PRECISION),
+                "DEBUG_CORE_*_PREC: precision must be 0~6");
+  using Traits = FieldTraits<T>;
+  if constexpr (Traits::COUNT != 1 || std::is_enum_v<T> ||
+                (std::is_floating_point_v<T> && !std::is_same_v<T, float>)) {
+    return &print_typed_field<T, Precision>;
+  } else {
+    return nullptr;
+  }
+}
+
+namespace detail {
+
+/**
+ * @brief 字段偏移、大小的编译期 16 位检查
+ */
+template <size_t Value>
+constexpr uint16_t field_u16() {
+  static_assert(Value <= UINT16_MAX,
+                "DebugCore snapshot fields must lie within 64 KiB");
+  return static_cast<uint16_t>(Value);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Live 模式字段描述
+ * @details 与模块类型无关：取值函数和自定义打印函数以 const void* 接收模块
+ *          实例，由字段宏生成的转换函数还原为模块类型，采集、格式化与命令执行
+ *          因此不随模块类型实例化。
+ */
+struct LiveField {
+  const char* name;
+  ViewMask view_mask;
+  /// 自定义打印，持锁期间调用；类型化字段为空
+  void (*print)(FrameWriter& out, const char* name, const void* self);
+  FieldType type = FieldType::CUSTOM;
+  /// 类型化字段：持锁期间把字段值写入 out
+  void (*read)(const void* self, void* out) = nullptr;
+  /// 类型化字段：解锁后按 read 写入的值格式化，为空时按类型标签打印
+  FieldPrintFn format = nullptr;
+  int8_t precision = -1;  ///< F32 小数位数，负数表示默认
+  uint16_t size = 0;  ///< 类型化字段值字节数
+  float deadband = 0.0f;  ///< delta 模式下 F32 字段的死区
+  Reduction reduce = Reduction::DEFAULT;  ///< 降采样时的规约方式
+};
+
+/**
+ * @brief Live 模式字段描述，Owner 仅用于接入代码标明所属模块
+ */
+template <typename Owner>
+using LiveFieldDesc = LiveField;
+
+/**
+ * @brief Live 模式中与模块类型、视图表类型相关的操作
+ * @details 每种 (Owner, ViewTable) 组合一份常量表，见 LIVE_OPS。
+ */
+struct LiveOps {
+  bool (*parse_view)(const void* views, const char* arg, uint8_t* out_view);
+  const char* (*view_name)(const void* views, uint8_t view);
+  /// 以模块实例调用原始签名为 void(Owner*) 的加锁 / 解锁回调
+  void (*call_lock)(void (*fn)(), void* self);
+};
+
+template <typename Owner, typename ViewTable>
+inline constexpr LiveOps LIVE_OPS = {
+    [](const void* views, const char* arg, uint8_t* out_view) {
+      return parse_view_name(arg, *static_cast<const ViewTable*>(views),
+                             out_view);
+    },
+    [](const void* views, uint8_t view) {
+      return view_name(view, *static_cast<const ViewTable*>(views));
+    },
+    [](void (*fn)(), void* self) {
+      reinterpret_cast<void (*)(Owner*)>(fn)(static_cast<Owner*>(self));
+    },
+};
+
+/**
+ * @brief Live 模式提供器（类型擦除）
+ * @details 由 run_live_command() 与 ProviderRegistry::Register() 的模板外壳
+ *          生成；后台任务按值保存，因此引用的字段表、视图表需具有静态生命周期。
+ */
+struct LiveProvider {
+  const LiveField* fields = nullptr;
+  size_t field_count = 0;
+  void* self = nullptr;
+  const char* module_name = nullptr;
+  const void* views = nullptr;
+  const LiveOps* ops = nullptr;
+  void (*lock)() = nullptr;    ///< 原始签名 void(Owner*)，经 ops->call_lock 调用
+  void (*unlock)() = nullptr;  ///< 原始签名 void(Owner*)，经 ops->call_lock 调用
+  FieldViewIndex field_index = {};
+
+  bool ParseView(const char* arg, uint8_t* out_view) const {
+    return ops->parse_view(views, arg, out_view);
+  }
+
+  const char* ViewName(uint8_t view) const {
+    return ops->view_name(views, view);
+  }
+};
+
+/**
+ * @brief 生成 Live 提供器
+ */
+template <typename Owner, typename ViewTable>
+LiveProvider make_live_provider(Owner* self, const char* module_name,
+                                const ViewTable& view_table,
+                                const LiveField* fields, size_t field_count,
+                                void (*lock_self)(Owner*),
+                                void (*unlock_self)(Owner*),
+                                const FieldViewIndex& field_index) {
+  LiveProvider provider;
+  provider.fields = fields;
+  provider.field_count = field_count;
+  provider.self = self;
+  provider.module_name = module_name;
+  provider.views = &view_table;
+  provider.ops = &LIVE_OPS<Owner, ViewTable>;
+  provider.lock = reinterpret_cast<void (*)()>(lock_self);
+  provider.unlock = reinterpret_cast<void (*)()>(unlock_self);
+  provider.field_index = field_index;
+  return provider;
+}
+
+/**
+ * @brief Live 模式单帧采集结果
+ * @details 持锁阶段只把选中的类型化字段值拷入定长缓冲区，自定义字段的打印输出
+ *          也只写入同一缓冲区；解锁后再统一格式化和输出，模块锁的持有时间与
+ *          控制台速度无关，且所有字段都取自同一时刻。
+ */
+class LiveCapture {
+ public:
+  /**
+   * @brief 持锁采集选中字段
+   * @param provider Live 提供器，其中的按视图字段索引可为空
+   * @param selection 视图选择，多视图时采集并集
+   */
+  void Capture(const LiveProvider& provider, const ViewSelection& selection) {
+    count_ = 0;
+    used_ = 0;
+    overflow_ = false;
+
+    if (provider.lock != nullptr) {
+      provider.ops->call_lock(provider.lock, provider.self);
+    }
+    timestamp_ms_ = static_cast<uint32_t>(LibXR::Thread::GetTime());
+    const void* self = provider.self;
+    for_each_view_field(
+        provider.fields, provider.field_count, selection,
+        provider.field_index, [&](const LiveField& f, size_t i) {
+          if (count_ >= DEBUG_CORE_LIVE_MAX_FIELDS) {
+            overflow_ = true;
+            return;
+          }
+          Slot& slot = slots_[count_];
+          slot.index = static_cast<uint16_t>(i);
+          if (f.read != nullptr) {
+            size_t offset = AlignFor(used_, f.size);
+            if (f.size > sizeof(buffer_) - offset) {
+              overflow_ = true;
+              return;
+            }
+            f.read(self, buffer_ + offset);
+            slot.offset = static_cast<uint16_t>(offset);
+            slot.length = f.size;
+            used_ = offset + f.size;
+          } else {
+            FrameWriter text(buffer_ + used_, sizeof(buffer_) - used_,
+                             FrameOverflow::TRUNCATE);
+            f.print(text, f.name, self);
+            overflow_ = overflow_ || text.Truncated();
+            slot.offset = static_cast<uint16_t>(used_);
+            slot.length = static_cast<uint16_t>(text.Size());
+            used_ += text.Size();
+          }
+          ++count_;
+        });
+    if (provider.unlock != nullptr) {
+      provider.ops->call_lock(provider.unlock, provider.self);
+    }
+  }
+
+  /**
+   * @brief 格式化采集结果，无需持锁
+   * @param delta delta 模式缓存，非空时只输出变化的字段
+   * @return size_t 输出的字段数
+   */
+  size_t Format(FrameWriter& out, const LiveField* fields,
+                DeltaCache* delta = nullptr) const {
+    size_t printed = 0;
+    for (size_t k = 0; k < count_; ++k) {
+      const Slot& slot = slots_[k];
+      const auto& f = fields[slot.index];
+      if (delta != nullptr &&
+          !delta->Update(buffer_ + slot.offset, slot.length,
+                         f.type == FieldType::F32 && f.size == sizeof(float),
+                         f.deadband)) {
+        continue;
+      }
+      ++printed;
+      if (f.read == nullptr) {
+        out.Write(buffer_ + slot.offset, slot.length);
+      } else if (f.format == nullptr) {
+        print_field_line(out, f.name, f.type, f.precision,
+                         buffer_ + slot.offset);
+      } else {
+        f.format(out, f.name, buffer_ + slot.offset);
+      }
+    }
+    if (overflow_) {
+      out.Write(FrameWriter::TRUNCATED_MARK, FrameWriter::TRUNCATED_MARK_LEN);
+    }
+    return printed;
+  }
+
+  /**
+   * @brief 把类型化字段累计到 stats，无需持锁
+   * @param group 所属模块，单模块会话为空
+   */
+  void Accumulate(StatsAccumulator& stats, const LiveField* fields,
+                  const char* group) const {
+    for (size_t k = 0; k < count_; ++k) {
+      const Slot& slot = slots_[k];
+      const auto& f = fields[slot.index];
+      if (f.read != nullptr) {
+        accumulate_field(stats, group, f.name, f.type, f.size,
+                         buffer_ + slot.offset);
+      }
+    }
+  }
+
+  /**
+   * @brief 降采样：累计类型化字段，无需持锁
+   */
+  void ReduceAdd(Reducer& reducer, const LiveField* fields) const {
+    for (size_t k = 0; k < count_; ++k) {
+      const auto& f = fields[slots_[k].index];
+      double value = 0.0;
+      if (f.read != nullptr &&
+          read_field_value(f.type, f.size, buffer_ + slots_[k].offset,
+                           &value)) {
+        reducer.Add(value);
+      }
+    }
+  }
+
+  /**
+   * @brief 降采样：把本周期的规约值写回值缓冲区，自定义字段保持最后一次
+   */
+  void ReduceTake(Reducer& reducer, const LiveField* fields) {
+    for (size_t k = 0; k < count_; ++k) {
+      const auto& f = fields[slots_[k].index];
+      char* value_ptr = buffer_ + slots_[k].offset;
+      double value = 0.0;
+      if (f.read == nullptr ||
+          !read_field_value(f.type, f.size, value_ptr, &value)) {
+        continue;
+      }
+      double result =
+          reducer.Take(f.reduce, field_type_is_float(f.type), value);
+      if (result != value) {
+        write_field_value(f.type, value_ptr, result);
+      }
+    }
+  }
+
+  /**
+   * @brief 采集时刻
+   */
+  uint32_t Timestamp() const { return timestamp_ms_; }
+
+ private:
+  struct Slot {
+    uint16_t index;
+    uint16_t offset;
+    uint16_t length;
+  };
+
+  static size_t AlignFor(size_t offset, size_t size) {
+    size_t align = size >= 8 ? 8 : (size >= 4 ? 4 : (size >= 2 ? 2 : 1));
+    return (offset + align - 1) & ~(align - 1);
+  }
+
+  alignas(8) char buffer_[DEBUG_CORE_LIVE_CAPTURE_SIZE];
+  Slot slots_[DEBUG_CORE_LIVE_MAX_FIELDS];
+  size_t count_ = 0;
+  size_t used_ = 0;
+  uint32_t timestamp_ms_ = 0;
+  bool overflow_ = false;
+};
+
+/**
+ * @brief Live 模式命令执行器（类型擦除）
+ * @details 所有模块共用一份实现；后台任务按值保存 provider。
+ */
+inline int run_live_command(const LiveProvider& provider,
+                            const char* view_help, int argc, char** argv,
+                            uint8_t default_view) {
+  auto parse_view = [&](const char* arg, ViewSelection* out) {
+    return parse_view_selection(
+        arg, default_view,
+        [&](const char* name, uint8_t* out_view) {
+          return provider.ParseView(name, out_view);
+        },
+        out);
+  };
+
+  auto print_usage = [&]() {
+    LibXR::STDIO::Printf<"Usage:\r\n">();
+    LibXR::STDIO::Printf<"  monitor\r\n">();
+    LibXR::STDIO::Printf<"  monitor <time_ms> [interval_ms] [%s] "
+                         "[stats[:K]|delta[:K]] [sample:<ms>[:mode]] [prof] "
+                         "[&]\r\n">(view_help);
+    LibXR::STDIO::Printf<"  once [%s]\r\n">(view_help);
+    LibXR::STDIO::Printf<"  %s\r\n">(view_help);
+    LibXR::STDIO::Printf<"  jobs | stop <id|all>\r\n">();
+  };
+
+  // 按值捕获：后台任务会拷贝该回调并在命令返回后继续使用
+  auto print_once = [provider](const ViewSelection& selection,
+                               const FrameContext& ctx) {
+    const LiveField* fields = provider.fields;
+    LiveCapture capture;
+    const uint32_t capture_begin = ctx.ProfileBegin();
+    capture.Capture(provider, selection);
+    ctx.ProfileEnd(ProfileStage::CAPTURE, capture_begin);
+
+    if (ctx.reducer != nullptr) {
+      ctx.reducer->BeginCapture();
+      capture.ReduceAdd(*ctx.reducer, fields);
+      if (!ctx.reduce_emit) {
+        return;
+      }
+      ctx.reducer->BeginOutput();
+      capture.ReduceTake(*ctx.reducer, fields);
+    }
+
+    if (ctx.accumulator != nullptr) {
+      ctx.accumulator->BeginSample(capture.Timestamp());
+      capture.Accumulate(*ctx.accumulator, fields, nullptr);
+      return;
+    }
+
+    bool keyframe = ctx.BeginDeltaFrame();
+    char name_buf[64];
+    FrameBuffer<> out;
+    out.Profile(ctx.profile);
+    out.Printf<"[%u ms] %s %s%s\r\n">(
+        static_cast<unsigned>(capture.Timestamp()), provider.module_name,
+        view_selection_name(
+            selection, [&](uint8_t v) { return provider.ViewName(v); },
+            name_buf, sizeof(name_buf)),
+        keyframe ? "" : " delta");
+    size_t printed = capture.Format(out, fields, ctx.delta_cache);
+    if (keyframe || printed > 0) {
+      out.Flush();
+    }
+  };
+
+  // Live 字段表没有二进制 schema
+  for (int i = 2; i < argc; ++i) {
+    if (std::strcmp(argv[i], "bin") == 0) {
+      LibXR::STDIO::Printf<"Error: bin output is not supported here.\r\n">();
+      return -1;
+    }
+  }
+
+  return run_command(argc, argv, ViewSelection::Of(default_view, default_view),
+                     parse_view, print_once, print_usage);
+}
+
+/**
+ * @brief Live 模式命令执行器
+ * @details 只负责把模块类型与视图表擦除为 LiveProvider，命令逻辑不随模块实例化。
+ * @tparam Owner 模块类型
+ * @tparam ViewTable 视图表类型：std::array<ViewEntry<uint8_t>, N> 或
+ *         make_view_lookup() 生成的 ViewLookup
+ */
+template <typename Owner, typename ViewTable>
+int run_live_command(
+    Owner* self, const char* module_name, const char* view_help,
+    const ViewTable& view_table,
+    const LiveFieldDesc<Owner>* fields, size_t field_count, int argc,
+    char** argv, uint8_t default_view, void (*lock_self)(Owner*) = nullptr,
+    void (*unlock_self)(Owner*) = nullptr,
+    const FieldViewIndex& field_index = {}) {
+  return run_live_command(
+      make_live_provider(self, module_name, view_table, fields, field_count,
+                         lock_self, unlock_self, field_index),
+      view_help, argc, argv, default_view);
+}
+
+/**
+ * @brief 二进制 schema 中字段名、模块名的最大长度
+ */
+constexpr size_t BINARY_NAME_MAX = 63;
+
+/// 帧头（类型 1 + 流编号 2）与帧尾 CRC 2 字节
+constexpr size_t BINARY_FRAME_OVERHEAD = 5;
+/// 长度前缀 1 字节 + 按 BINARY_NAME_MAX 截断的名称
+constexpr size_t BINARY_NAME_FIELD_MAX = 1 + BINARY_NAME_MAX;
+
+/**
+ * @brief 各 schema 帧的最大原始长度（含 CRC），名称均按最长计
+ */
+constexpr size_t SCHEMA_NAME_FRAME_MAX =
+    BINARY_FRAME_OVERHEAD + 2 + BINARY_NAME_FIELD_MAX;
+constexpr size_t SCHEMA_MODULE_FRAME_MAX =
+    BINARY_FRAME_OVERHEAD + 2 + 2 + BINARY_NAME_FIELD_MAX + 1 + 2;
+constexpr size_t SCHEMA_VIEW_FRAME_MAX =
+    BINARY_FRAME_OVERHEAD + 1 + BINARY_NAME_FIELD_MAX;
+constexpr size_t SCHEMA_FIELD_FRAME_MAX =
+    BINARY_FRAME_OVERHEAD + 2 + 2 + 2 + 1 + ViewMask::BYTES +
+    BINARY_NAME_FIELD_MAX;
+
+/// Structured SAMPLE 帧的最大原始长度：序号 2 + 时间戳 4 + 视图掩码 + 全部快照
+constexpr size_t sample_frame_max(size_t snapshot_size) {
+  return BINARY_FRAME_OVERHEAD + 2 + 4 + ViewMask::BYTES + snapshot_size;
+}
+
+/**
+ * @brief 输出一帧二进制帧
+ * @details 各帧缓冲区按帧布局的最大长度分配，内容超出容量说明容量计算有误：
+ *          调试构建下断言失败，而不是静默丢弃该帧。
+ * @return bool 输出成功返回 true
+ */
+inline bool send_binary_frame(BinaryFrame& frame) {
+  ASSERT(!frame.Overflowed());
+  return frame.Send(write_bytes);
+}
+
+/**
+ * @brief 以小端写入视图掩码（ViewMask::BYTES 字节，32 个视图时即 u32）
+ */
+inline void put_view_mask(BinaryFrame& frame, const ViewMask& mask) {
+  for (size_t i = 0; i < ViewMask::WORDS; ++i) {
+    frame.PutU32(mask.Word(i));
+  }
+}
+
+/**
+ * @brief 发送共享名称池
+ * @details 每个名称单独成帧，流编号为名称池编号。同一会话中共用该名称池的
+ *          模块只需发送一次，其字段与视图描述随后只携带名称编号。
+ */
+inline void send_name_pool(const NamePool& names) {
+  BinaryFrameBuffer<SCHEMA_NAME_FRAME_MAX> frame;
+  for (uint16_t i = 0; i < names.Size(); ++i) {
+    frame.Begin(BinaryKind::SCHEMA_NAME, names.id);
+    frame.PutU16(i);
+    frame.PutString(names.Name(i), BINARY_NAME_MAX);
+    send_binary_frame(frame);
+  }
+}
+
+/**
+ * @brief 发送 Structured 模式的二进制 schema
+ * @details 依次发送模块描述、所有可解析的视图描述和逐字段描述，
+ *          每条记录单独成帧，接收端据此解码后续 SAMPLE 帧。提供名称池时，
+ *          池中已有的视图名与字段名以名称编号代替，名称池需已由
+ *          send_name_pool() 发送。
+ */
+inline void send_structured_schema(uint16_t stream, const char* module_name,
+                                   const FieldDesc* fields, size_t field_count,
+                                   size_t snapshot_size,
+                                   bool (*parse_view)(const char*, uint8_t*),
+                                   const char* (*view_to_string)(uint8_t),
+                                   const NamePool& names = {}) {
+  // 字段描述帧最长，模块与视图描述帧共用同一缓冲区
+  static_assert(SCHEMA_MODULE_FRAME_MAX <= SCHEMA_FIELD_FRAME_MAX &&
+                SCHEMA_VIEW_FRAME_MAX <= SCHEMA_FIELD_FRAME_MAX);
+  BinaryFrameBuffer<SCHEMA_FIELD_FRAME_MAX> frame;
+
+  frame.Begin(BinaryKind::SCHEMA_MODULE, stream);
+  frame.PutU16(static_cast<uint16_t>(field_count));
+  frame.PutU16(static_cast<uint16_t>(snapshot_size));
+  frame.PutString(module_name, BINARY_NAME_MAX);
+  frame.PutU8(static_cast<uint8_t>(ViewMask::BYTES));
+  frame.PutU16(names.Empty() ? 0 : names.id);
+  send_binary_frame(frame);
+
+  if (parse_view != nullptr && view_to_string != nullptr) {
+    for (uint32_t view = 0; view < ViewMask::BITS; ++view) {
+      const char* name = view_to_string(static_cast<uint8_t>(view));
+      uint8_t parsed = 0;
+      if (name == nullptr || !parse_view(name, &parsed) || parsed != view) {
+        continue;
+      }
+      uint16_t name_id = names.Find(name);
+      if (name_id != NAME_NONE) {
+        frame.Begin(BinaryKind::SCHEMA_VIEW_ID, stream);
+        frame.PutU8(static_cast<uint8_t>(view));
+        frame.PutU16(name_id);
+      } else {
+        frame.Begin(BinaryKind::SCHEMA_VIEW, stream);
+        frame.PutU8(static_cast<uint8_t>(view));
+        frame.PutString(name, BINARY_NAME_MAX);
+      }
+      send_binary_frame(frame);
+    }
+  }
+
+  for (size_t i = 0; i < field_count; ++i) {
+    const auto& f = fields[i];
+    uint16_t name_id = names.Find(f.name);
+    frame.Begin(name_id != NAME_NONE ? BinaryKind::SCHEMA_FIELD_ID
+                                     : BinaryKind::SCHEMA_FIELD,
+                stream);
+    frame.PutU16(static_cast<uint16_t>(i));
+    frame.PutU16(static_cast<uint16_t>(f.offset));
+    frame.PutU16(f.size);
+    frame.PutU8(static_cast<uint8_t>(f.type));
+    put_view_mask(frame, f.view_mask);
+    if (name_id != NAME_NONE) {
+      frame.PutU16(name_id);
+    } else {
+      frame.PutString(f.name, BINARY_NAME_MAX);
+    }
+    send_binary_frame(frame);
+  }
+}
+
+/**
+ * @brief 发送一帧 Structured 二进制采样
+ * @details 负载为选中字段按表顺序紧密排列的原始字节；帧中的 selected_mask
+ *          为所选视图位的并集，全 1 表示全部字段。
+ */
+inline void send_structured_sample(BinaryFrame& frame, uint16_t stream,
+                                   uint32_t sequence, uint32_t timestamp_ms,
+                                   const ViewSelection& selection,
+                                   const FieldDesc* fields, size_t field_count,
+                                   const uint8_t* base,
+                                   const FieldViewIndex& index = {}) {
+  frame.Begin(BinaryKind::SAMPLE, stream);
+  frame.PutU16(static_cast<uint16_t>(sequence));
+  frame.PutU32(timestamp_ms);
+  put_view_mask(frame, selection.full ? ViewMask::All() : selection.mask);
+  for_each_view_field(fields, field_count, selection, index,
+                      [&](const FieldDesc& f, size_t) {
+                        frame.PutBytes(base + f.offset, f.size);
+                      });
+  send_binary_frame(frame);
+}
+
+/**
+ * @brief 按视图选择打印 Structured 快照字段
+ * @param delta delta 模式缓存，非空时只打印变化的字段
+ * @param index 按视图字段索引，可为空
+ * @return size_t 打印的字段数
+ */
+inline size_t print_structured_fields(FrameWriter& out, const FieldDesc* fields,
+                                      size_t field_count, const uint8_t* base,
+                                      const ViewSelection& selection,
+                                      DeltaCache* delta = nullptr,
+                                      const FieldViewIndex& index = {}) {
+  size_t printed = 0;
+  for_each_view_field(
+      fields, field_count, selection, index, [&](const FieldDesc& f, size_t) {
+        if (delta != nullptr && f.size > 0 &&
+            !delta->Update(base + f.offset, f.size,
+                           f.type == FieldType::F32 && f.size == sizeof(float),
+                           f.deadband)) {
+          return;
+        }
+        if (f.print == nullptr) {
+          print_field_line(out, f.name, f.type, f.precision, base + f.offset);
+        } else {
+          f.print(out, f.name, base + f.offset);
+        }
+        ++printed;
+      });
+  return printed;
+}
+
+/**
+ * @brief 输出飞行记录器中的快照
+ * @details 参数格式 `dump [count] [view] [bin]`，按时间从旧到新输出最近 count
+ *          条记录（默认全部），每条记录一帧，时间戳为记录时刻。
+ * @return int 命令返回值
+ */
+inline int run_dump_command(void* self, const StructuredProviderBase& provider,
+                            int argc, char** argv, uint8_t default_view) {
+  SnapshotRecorderBase* recorder = provider.ops->recorder(provider, self);
+  if (recorder == nullptr) {
+    LibXR::STDIO::Printf<"Error: No flight recorder.\r\n">();
+    return -1;
+  }
+
+  FrameContext ctx;
+  while (argc > 2 && parse_output_option(argv[argc - 1], &ctx)) {
+    --argc;
+  }
+  // 回放没有会话状态，只接受 bin
+  if (const char* mode = ctx.SessionOption()) {
+    LibXR::STDIO::Printf<"Error: %s output is not supported here.\r\n">(mode);
+    return -1;
+  }
+
+  size_t count = 0;
+  ViewSelection selection = ViewSelection::Of(default_view, default_view);
+  bool has_count = false;
+  bool has_view = false;
+  for (int i = 2; i < argc; ++i) {
+    if (!has_view &&
+        parse_structured_selection(provider, argv[i], default_view,
+                                   &selection)) {
+      has_view = true;
+      continue;
+    }
+    int value = std::atoi(argv[i]);
+    if (has_count || has_view || value <= 0) {
+      LibXR::STDIO::Printf<"Error: Invalid dump args. Use dump [count] [view] "
+                           "[bin].\r\n">();
+      return -1;
+    }
+    count = static_cast<size_t>(value);
+    has_count = true;
+  }
+
+  const uint16_t stream = crc16(provider.module_name);
+  if (ctx.format == OutputFormat::BINARY) {
+    if (!provider.names.Empty()) {
+      send_name_pool(provider.names);
+    }
+    send_structured_schema(stream, provider.module_name, provider.fields,
+                           provider.field_count, provider.ops->snapshot_size,
+                           provider.parse_view, provider.view_to_string,
+                           provider.names);
+  }
+  char name_buf[64];
+  const char* current_view_name =
+      structured_selection_name(provider, selection, name_buf,
+                                sizeof(name_buf));
+
+  size_t total = recorder->Dump(count, [&](uint32_t timestamp_ms,
+                                           const uint8_t* base, bool trigger) {
+    if (ctx.format == OutputFormat::BINARY) {
+      struct Sample {
+        const StructuredProviderBase& provider;
+        FrameContext& ctx;
+        const ViewSelection& selection;
+        uint16_t stream;
+        uint32_t timestamp_ms;
+        const uint8_t* base;
+      } sample{provider, ctx, selection, stream, timestamp_ms, base};
+      provider.ops->with_buffers(
+          [](void* arg, uint8_t*, BinaryFrame& frame) {
+            auto& s = *static_cast<Sample*>(arg);
+            send_structured_sample(frame, s.stream, s.ctx.sequence++,
+                                   s.timestamp_ms, s.selection,
+                                   s.provider.fields, s.provider.field_count,
+                                   s.base, s.provider.field_index);
+          },
+          &sample);
+      return;
+    }
+    FrameBuffer<> out;
+    out.Printf<"[%u ms] %s %s #%u%s\r\n">(
+        static_cast<unsigned>(timestamp_ms), provider.module_name,
+        current_view_name, static_cast<unsigned>(ctx.sequence++),
+        trigger ? " <trigger>" : "");
+    print_structured_fields(out, provider.fields, provider.field_count, base,
+                            selection, nullptr, provider.field_index);
+    out.Flush();
+  });
+
+  if (ctx.format == OutputFormat::TEXT) {
+    LibXR::STDIO::Printf<"[dump] %u/%u entries\r\n">(
+        static_cast<unsigned>(total),
+        static_cast<unsigned>(recorder->Capacity()));
+  }
+  return 0;
+}
+
+/**
+ * @brief 解析触发条件
+ * @details 电平：`>` `>=` `<` `<=` `==` `!=`（或 gt/ge/lt/le/eq/ne）；
+ *          边沿：`rise` / `fall`。
+ */
+inline bool parse_trigger_op(const char* arg, TriggerOp* out_op) {
+  struct OpName {
+    const char* symbol;
+    const char* word;
+    TriggerOp op;
+  };
+  static constexpr OpName OPS[] = {
+      {">", "gt", TriggerOp::GT},   {">=", "ge", TriggerOp::GE},
+      {"<", "lt", TriggerOp::LT},   {"<=", "le", TriggerOp::LE},
+      {"==", "eq", TriggerOp::EQ},  {"!=", "ne", TriggerOp::NE},
+      {"rise", "up", TriggerOp::RISE}, {"fall", "down", TriggerOp::FALL},
+  };
+  for (const auto& item : OPS) {
+    if (std::strcmp(arg, item.symbol) == 0 || std::strcmp(arg, item.word) == 0) {
+      *out_op = item.op;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 解析触发阈值，BOOL 字段额外接受 true/false
+ */
+inline bool parse_trigger_value(const char* arg, FieldType type,
+                                float* out_value) {
+  if (type == FieldType::BOOL) {
+    if (std::strcmp(arg, "true") == 0) {
+      *out_value = 1.0f;
+      return true;
+    }
+    if (std::strcmp(arg, "false") == 0) {
+      *out_value = 0.0f;
+      return true;
+    }
+  }
+  char* end = nullptr;
+  *out_value = std::strtof(arg, &end);
+  return end != arg && *end == '\0';
+}
+
+/**
+ * @brief 触发捕获命令
+ * @details 参数格式：
+ *          - `trigger`：查看状态
+ *          - `trigger off`：撤防并恢复录制
+ *          - `trigger <field> <op> <value> [pre] [post]`：布防，捕获完成后
+ *            用 `dump` 输出触发窗口
+ * @return int 命令返回值
+ */
+inline int run_trigger_command(void* self,
+                               const StructuredProviderBase& provider,
+                               int argc, char** argv) {
+  SnapshotRecorderBase* recorder = provider.ops->recorder(provider, self);
+  if (recorder == nullptr) {
+    LibXR::STDIO::Printf<"Error: No flight recorder.\r\n">();
+    return -1;
+  }
+
+  if (argc == 2) {
+    static constexpr const char* STATE_NAMES[] = {"idle", "armed", "triggered",
+                                                  "captured"};
+    LibXR::STDIO::Printf<"[trigger] %s\r\n">(
+        STATE_NAMES[static_cast<uint8_t>(recorder->GetTriggerState())]);
+    return 0;
+  }
+  if (argc == 3 && std::strcmp(argv[2], "off") == 0) {
+    recorder->Disarm();
+    LibXR::STDIO::Printf<"[trigger] off\r\n">();
+    return 0;
+  }
+  if (argc < 5 || argc > 7) {
+    LibXR::STDIO::Printf<"Error: Use trigger <field> <op> <value> [pre] "
+                         "[post] | trigger off.\r\n">();
+    return -1;
+  }
+
+  const FieldDesc* field = nullptr;
+  for (size_t i = 0; i < provider.field_count; ++i) {
+    if (std::strcmp(provider.fields[i].name, argv[2]) == 0) {
+      field = &provider.fields[i];
+      break;
+    }
+  }
+  if (field == nullptr || field_type_size(field->type) == 0 ||
+      (field->size != 0 && field->size != field_type_size(field->type))) {
+    LibXR::STDIO::Printf<"Error: Field '%s' not found or not a scalar.\r\n">(
+        argv[2]);
+    return -1;
+  }
+
+  TriggerConfig config{};
+  config.offset = field->offset;
+  config.type = field->type;
+  if (!parse_trigger_op(argv[3], &config.op)) {
+    LibXR::STDIO::Printf<"Error: Invalid op '%s'.\r\n">(argv[3]);
+    return -1;
+  }
+  if (!parse_trigger_value(argv[4], config.type, &config.threshold)) {
+    LibXR::STDIO::Printf<"Error: Invalid value '%s'.\r\n">(argv[4]);
+    return -1;
+  }
+
+  const size_t capacity = recorder->Capacity();
+  int pre = argc > 5 ? std::atoi(argv[5]) : static_cast<int>((capacity - 1) / 2);
+  int post = argc > 6 ? std::atoi(argv[6])
+                      : static_cast<int>(capacity - 1) - pre;
+  if (pre < 0 || post < 0 || static_cast<size_t>(pre) + post + 1 > capacity) {
+    LibXR::STDIO::Printf<"Error: pre + post must be < %u.\r\n">(
+        static_cast<unsigned>(capacity));
+    return -1;
+  }
+  config.pre = static_cast<uint16_t>(pre);
+  config.post = static_cast<uint16_t>(post);
+
+  recorder->Arm(config);
+  LibXR::STDIO::Printf<"[trigger] armed %s %s %s pre=%d post=%d\r\n">(
+      field->name, argv[3], argv[4], pre, post);
+  return 0;
+}
+
+/**
+ * @brief Structured 模式单帧输出
+ * @details 由 StructuredOps::with_buffers 在栈上提供快照存储与二进制帧缓冲区后
+ *          调用，arg 指向 StructuredFrameArgs。
+ */
+struct StructuredFrameArgs {
+  const StructuredProviderBase* desc;
+  void* self;
+  const ViewSelection* selection;
+  const FrameContext* ctx;
+};
+
+inline void print_structured_frame(void* arg, uint8_t* snapshot,
+                                   BinaryFrame& frame) {
+  const auto& args = *static_cast<const StructuredFrameArgs*>(arg);
+  const StructuredProviderBase* desc = args.desc;
+  const ViewSelection& selection = *args.selection;
+  const FrameContext& ctx = *args.ctx;
+  // 时间戳紧贴抓取之前取一次，文本、二进制与 stats 输出共用，不含规约与
+  // 格式化的耗时
+  const uint32_t timestamp_ms =
+      static_cast<uint32_t>(LibXR::Thread::GetTime());
+  const uint32_t capture_begin = ctx.ProfileBegin();
+  desc->ops->capture(*desc, args.self, snapshot);
+  ctx.ProfileEnd(ProfileStage::CAPTURE, capture_begin);
+
+  if (ctx.reducer != nullptr) {
+    ctx.reducer->BeginCapture();
+    reduce_add_structured(*ctx.reducer, desc->fields, desc->field_count,
+                          snapshot, selection, desc->field_index);
+    if (!ctx.reduce_emit) {
+      return;
+    }
+    ctx.reducer->BeginOutput();
+    reduce_take_structured(*ctx.reducer, desc->fields, desc->field_count,
+                           snapshot, selection, desc->field_index);
+  }
+
+  if (ctx.accumulator != nullptr) {
+    ctx.accumulator->BeginSample(timestamp_ms);
+    accumulate_structured_fields(*ctx.accumulator, nullptr, desc->fields,
+                                 desc->field_count, snapshot, selection,
+                                 desc->field_index);
+    return;
+  }
+
+  if (ctx.format == OutputFormat::BINARY) {
+    uint16_t stream = crc16(desc->module_name);
+    if (ctx.sequence == 0) {
+      if (!desc->names.Empty()) {
+        send_name_pool(desc->names);
+      }
+      send_structured_schema(stream, desc->module_name, desc->fields,
+                             desc->field_count, desc->ops->snapshot_size,
+                             desc->parse_view, desc->view_to_string,
+                             desc->names);
+    }
+    send_structured_sample(frame, stream, ctx.sequence, timestamp_ms,
+                           selection, desc->fields, desc->field_count,
+                           snapshot, desc->field_index);
+    return;
+  }
+
+  bool keyframe = ctx.BeginDeltaFrame();
+  char name_buf[64];
+  FrameBuffer<> out;
+  out.Profile(ctx.profile);
+  auto current_view_name =
+      structured_selection_name(*desc, selection, name_buf, sizeof(name_buf));
+  out.Printf<"[%u ms] %s %s%s\r\n">(
+      static_cast<unsigned>(timestamp_ms), desc->module_name,
+      current_view_name, keyframe ? "" : " delta");
+  size_t printed =
+      print_structured_fields(out, desc->fields, desc->field_count, snapshot,
+                              selection, ctx.delta_cache, desc->field_index);
+  // delta 帧没有字段变化时整帧省略
+  if (keyframe || printed > 0) {
+    out.Flush();
+  }
+}
+
+/**
+ * @brief Structured 模式命令执行器
+ * @details 与快照类型无关，所有模块共用一份实现；快照类型相关的抓取与缓冲区
+ *          大小经 provider.ops 取得。
+ */
+inline int run_structured_command(void* self,
+                                  const StructuredProviderBase& provider,
+                                  int argc, char** argv,
+                                  uint8_t default_view) {
+  auto print_usage = [&]() {
+    LibXR::STDIO::Printf<"Usage:\r\n">();
+    LibXR::STDIO::Printf<"  monitor\r\n">();
+    LibXR::STDIO::Printf<"  monitor <time_ms> [interval_ms] [%s] "
+                         "[bin|stats[:K]|delta[:K]] [sample:<ms>[:mode]] "
+                         "[prof] [&]\r\n">(provider.view_help);
+    LibXR::STDIO::Printf<"  once [%s] [bin]\r\n">(provider.view_help);
+    LibXR::STDIO::Printf<"  %s\r\n">(provider.view_help);
+    if (provider.ops->recorder(provider, self) != nullptr) {
+      LibXR::STDIO::Printf<"  dump [count] [%s] [bin]\r\n">(
+          provider.view_help);
+      LibXR::STDIO::Printf<"  trigger [<field> <op> <value> [pre] [post] | off]"
+                           "\r\n">();
+    }
+    LibXR::STDIO::Printf<"  jobs | stop <id|all>\r\n">();
+  };
+
+  if (argc >= 2 && std::strcmp(argv[1], "dump") == 0) {
+    return run_dump_command(self, provider, argc, argv, default_view);
+  }
+  if (argc >= 2 && std::strcmp(argv[1], "trigger") == 0) {
+    return run_trigger_command(self, provider, argc, argv);
+  }
+
+  // 按值捕获：后台任务会拷贝该回调并在命令返回后继续使用；提供器需具有静态
+  // 生命周期，只捕获其地址
+  const StructuredProviderBase* desc = &provider;
+  auto print_once = [=](const ViewSelection& selection,
+                        const FrameContext& ctx) {
+    StructuredFrameArgs args{desc, self, &selection, &ctx};
+    desc->ops->with_buffers(print_structured_frame, &args);
+  };
+
+  auto parse_view = [&](const char* arg, ViewSelection* out) {
+    return parse_structured_selection(provider, arg, default_view, out);
+  };
+  return run_command(argc, argv, ViewSelection::Of(default_view, default_view),
+                     parse_view, print_once, print_usage);
+}
+
+/**
+ * @brief 注册表中的类型擦除提供器
+ */
+struct ProviderEntry {
+  const char* name = nullptr;
+  void* self = nullptr;
+  const void* desc = nullptr;   ///< StructuredProviderBase 或 Live 字段表
+  const void* views = nullptr;  ///< Live 视图表
+  const LiveOps* live_ops = nullptr;  ///< Live 视图表与加锁回调的操作
+  const FieldDesc* fields = nullptr;  ///< Structured 字段表
+  size_t field_count = 0;
+  FieldViewIndex field_index = {};  ///< 按视图字段索引，可为空
+  size_t snapshot_size = 0;  ///< Structured 快照大小，Live 为 0
+  uint8_t default_view = 0;
+  /// Structured 提供器原始视图回调，用于二进制 schema
+  bool (*structured_parse_view)(const char* arg, uint8_t* out_view) = nullptr;
+  const char* (*structured_view_to_string)(uint8_t view) = nullptr;
+  void (*lock)() = nullptr;    ///< Live 加锁回调（原始签名 void(Owner*)）
+  void (*unlock)() = nullptr;  ///< Live 解锁回调（原始签名 void(Owner*)）
+  bool (*parse_view)(const ProviderEntry& entry, const char* arg,
+                     uint8_t* out_view) = nullptr;
+  const char* (*view_name)(const ProviderEntry& entry, uint8_t view) = nullptr;
+  /// Structured：抓取快照到 out
+  void (*capture)(const ProviderEntry& entry, void* out) = nullptr;
+  /// Live：持锁采集选中字段，再格式化到 out
+  void (*capture_text)(const ProviderEntry& entry, FrameWriter& out,
+                       const ViewSelection& selection) = nullptr;
+  /// Live：持锁采集选中字段，再累计到 stats
+  void (*capture_stats)(const ProviderEntry& entry, StatsAccumulator& stats,
+                        const ViewSelection& selection) = nullptr;
+};
+
+/**
+ * @brief 合并采样的模块与视图选择
+ */
+struct SamplerSelection {
+  uint32_t providers = 0;  ///< 按注册序号的位掩码
+  ViewSelection views[DEBUG_CORE_MAX_PROVIDERS] = {};
+};
+
+/**
+ * @brief 全局提供器注册表与合并采样器
+ * @details 各模块在构造时注册自己的 StructuredProvider 或 Live 字段表；采样时
+ *          先在同一时刻依次抓取所有选中模块（Structured 抓快照，Live 持锁格式化
+ *          到暂存区），再统一输出一帧带公共时间戳的合并帧。注册表与 DebugCore
+ *          实例的构造顺序无关。
+ */
+class ProviderRegistry {
+ public:
+  static_assert(DEBUG_CORE_MAX_PROVIDERS <= 32,
+                "SamplerSelection uses a 32-bit provider mask");
+
+  /**
+   * @brief 获取全局注册表
+   */
+  static ProviderRegistry& Instance() {
+    static ProviderRegistry registry;
+    return registry;
+  }
+
+  /**
+   * @brief 注册 Structured 提供器
+   * @param self 模块实例
+   * @param provider 提供器，需具有静态生命周期
+   * @param default_view 默认（full）视图
+   * @return bool 注册成功返回 true；快照与其二进制帧放不进暂存区时返回 false
+   */
+  bool Register(void* self, const StructuredProviderBase& provider,
+                uint8_t default_view) {
+    if (StructuredArenaSize(provider.ops->snapshot_size) > sizeof(arena_)) {
+      return false;
+    }
+    ProviderEntry entry;
+    entry.name = provider.module_name;
+    entry.self = self;
+    entry.desc = &provider;
+    entry.fields = provider.fields;
+    entry.field_count = provider.field_count;
+    entry.field_index = provider.field_index;
+    entry.snapshot_size = provider.ops->snapshot_size;
+    entry.default_view = default_view;
+    entry.structured_parse_view = provider.parse_view;
+    entry.structured_view_to_string = provider.view_to_string;
+    entry.parse_view = [](const ProviderEntry& e, const char* arg,
+                          uint8_t* out_view) {
+      return e.structured_parse_view != nullptr &&
+             e.structured_parse_view(arg, out_view);
+    };
+    entry.view_name = [](const ProviderEntry& e, uint8_t view) {
+      return e.structured_view_to_string ? e.structured_view_to_string(view)
+                                         : "unknown";
+    };
+    entry.capture = [](const ProviderEntry& e, void* out) {
+      auto* p = static_cast<const StructuredProviderBase*>(e.desc);
+      p->ops->capture(*p, e.self, out);
+    };
+    return Add(entry);
+  }
+
+  /**
+   * @brief 注册 Live 字段表
+   * @param view_table 视图表，需具有静态生命周期
+   * @param fields 字段表，需具有静态生命周期
+   * @return bool 注册成功返回 true
+   */
+  template <typename Owner, typename ViewTable>
+  bool Register(Owner* self, const char* module_name,
+                const ViewTable& view_table,
+                const LiveFieldDesc<Owner>* fields, size_t field_count,
+                uint8_t default_view, void (*lock_self)(Owner*) = nullptr,
+                void (*unlock_self)(Owner*) = nullptr,
+                const FieldViewIndex& field_index = {}) {
+    return RegisterLive(
+        make_live_provider(self, module_name, view_table, fields, field_count,
+                           lock_self, unlock_self, field_index),
+        default_view);
+  }
+
+  /**
+   * @brief 注册 Live 提供器
+   * @return bool 注册成功返回 true
+   */
+  bool RegisterLive(const LiveProvider& provider, uint8_t default_view) {
+    ProviderEntry entry;
+    entry.name = provider.module_name;
+    entry.self = provider.self;
+    entry.desc = provider.fields;
+    entry.views = provider.views;
+    entry.live_ops = provider.ops;
+    entry.field_count = provider.field_count;
+    entry.field_index = provider.field_index;
+    entry.default_view = default_view;
+    entry.lock = provider.lock;
+    entry.unlock = provider.unlock;
+    entry.parse_view = [](const ProviderEntry& e, const char* arg,
+                          uint8_t* out_view) {
+      return e.live_ops->parse_view(e.views, arg, out_view);
+    };
+    entry.view_name = [](const ProviderEntry& e, uint8_t view) {
+      return e.live_ops->view_name(e.views, view);
+    };
+    entry.capture_text = [](const ProviderEntry& e, FrameWriter& out,
+                            const ViewSelection& selection) {
+      LiveCapture capture;
+      capture.Capture(LiveOf(e), selection);
+      capture.Format(out, static_cast<const LiveField*>(e.desc));
+    };
+    entry.capture_stats = [](const ProviderEntry& e, StatsAccumulator& stats,
+                             const ViewSelection& selection) {
+      LiveCapture capture;
+      capture.Capture(LiveOf(e), selection);
+      capture.Accumulate(stats, static_cast<const LiveField*>(e.desc), e.name);
+    };
+    return Add(entry);
+  }
+
+  /**
+   * @brief 解析合并采样选择
+   * @param arg `all` 或 `module[.view][,module[.view]...]`
+   * @param out 输出选择
+   * @return bool 解析成功返回 true
+   */
+  bool ParseSelection(const char* arg, SamplerSelection* out) const {
+    if (arg == nullptr || out == nullptr) {
+      return false;
+    }
+    if (std::strcmp(arg, "all") == 0) {
+      *out = All();
+      return true;
+    }
+
+    SamplerSelection selection;
+    const char* token = arg;
+    while (*token != '\0') {
+      const char* end = std::strchr(token, ',');
+      size_t len = end ? static_cast<size_t>(end - token) : std::strlen(token);
+      const char* dot = static_cast<const char*>(std::memchr(token, '.', len));
+      size_t name_len = dot ? static_cast<size_t>(dot - token) : len;
+
+      size_t index = FindByName(token, name_len);
+      if (index >= count_) {
+        return false;
+      }
+      const ProviderEntry& entry = entries_[index];
+      ViewSelection view =
+          ViewSelection::Of(entry.default_view, entry.default_view);
+      if (dot != nullptr) {
+        char view_arg[64];
+        size_t view_len = len - name_len - 1;
+        if (view_len == 0 || view_len >= sizeof(view_arg)) {
+          return false;
+        }
+        std::memcpy(view_arg, dot + 1, view_len);
+        view_arg[view_len] = '\0';
+        auto parse_one = [&](const char* name, uint8_t* out_view) {
+          return entry.parse_view(entry, name, out_view);
+        };
+        if (!parse_view_selection(view_arg, entry.default_view, parse_one,
+                                  &view)) {
+          return false;
+        }
+      }
+      selection.providers |= 1u << index;
+      selection.views[index] = view;
+
+      token += len;
+      if (*token == ',') {
+        ++token;
+      }
+    }
+    if (selection.providers == 0) {
+      return false;
+    }
+    *out = selection;
+    return true;
+  }
+
+  /**
+   * @brief 全部已注册模块的默认视图
+   */
+  SamplerSelection All() const {
+    SamplerSelection selection;
+    for (size_t i = 0; i < count_; ++i) {
+      selection.providers |= 1u << i;
+      selection.views[i] =
+          ViewSelection::Of(entries_[i].default_view, entries_[i].default_view);
+    }
+    return selection;
+  }
+
+  /**
+   * @brief 打印已注册模块列表
+   */
+  void PrintList() const {
+    if (count_ == 0) {
+      LibXR::STDIO::Printf<"  no providers registered\r\n">();
+      return;
+    }
+    for (size_t i = 0; i < count_; ++i) {
+      const ProviderEntry& e = entries_[i];
+      LibXR::STDIO::Printf<"  %s  %s  fields=%u default=%s\r\n">(
+          e.name, e.snapshot_size > 0 ? "structured" : "live",
+          static_cast<unsigned>(e.field_count),
+          e.view_name(e, e.default_view));
+    }
+  }
+
+  /**
+   * @brief 在同一时刻抓取所有选中模块并输出一帧合并帧
+   * @details 文本模式下每个模块输出一个小节；二进制模式下每个 Structured 模块
+   *          输出一个带公共时间戳的 SAMPLE 帧，Live 模块不参与二进制输出。
+   *          暂存区按注册顺序分配：Structured 快照先到先得，Live 文本只能均分
+   *          扣除后续 Structured 快照后的剩余空间；放不下的模块在文本模式下
+   *          只输出小节标题与截断标记。
+   */
+  void Sample(const SamplerSelection& selection, const FrameContext& ctx) {
+    LibXR::Mutex::LockGuard lock_guard(mutex_);
+
+    if (ctx.accumulator != nullptr) {
+      SampleStats(selection, ctx);
+      return;
+    }
+
+    // 抓取阶段：全部模块在同一时刻背靠背完成，输出阶段不再读取模块状态
+    const uint32_t timestamp_ms =
+        static_cast<uint32_t>(LibXR::Thread::GetTime());
+    const uint8_t* captured[DEBUG_CORE_MAX_PROVIDERS] = {};
+    size_t captured_size[DEBUG_CORE_MAX_PROVIDERS] = {};
+    uint32_t skipped = 0;
+    // 降采样时 Live 模块只在输出帧采集，即取最后值
+    const bool live_text = ctx.format == OutputFormat::TEXT &&
+                           (ctx.reducer == nullptr || ctx.reduce_emit);
+    size_t later_snapshots = 0;
+    size_t live_left = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      if ((selection.providers & (1u << i)) != 0) {
+        if (entries_[i].snapshot_size > 0) {
+          later_snapshots += Align(entries_[i].snapshot_size);
+        } else if (live_text) {
+          ++live_left;
+        }
+      }
+    }
+
+    size_t used = 0;
+    size_t frame_reserve = 0;  // 二进制模式下已抓取模块中最大的帧缓冲
+    // Live 模块在抓取阶段即生成文本，prof 模式下一并计为采集
+    const uint32_t capture_begin = ctx.ProfileBegin();
+    for (size_t i = 0; i < count_; ++i) {
+      if ((selection.providers & (1u << i)) == 0) {
+        continue;
+      }
+      const ProviderEntry& e = entries_[i];
+      used = Align(used);
+      const size_t room = sizeof(arena_) - used;
+      if (e.snapshot_size > 0) {
+        later_snapshots -= Align(e.snapshot_size);
+        size_t frame = 0;
+        if (ctx.format == OutputFormat::BINARY) {
+          frame = SampleFrameSize(e.snapshot_size);
+          frame = frame > frame_reserve ? frame : frame_reserve;
+        }
+        if (Align(e.snapshot_size) + frame > room) {
+          skipped |= 1u << i;
+          continue;
+        }
+        frame_reserve = frame;
+        e.capture(e, arena_ + used);
+        captured_size[i] = e.snapshot_size;
+      } else if (live_text) {
+        size_t share = room > later_snapshots ? room - later_snapshots : 0;
+        share = AlignDown(share / live_left--);
+        if (share <= FrameWriter::TRUNCATED_MARK_LEN + 1) {
+          skipped |= 1u << i;
+          continue;
+        }
+        FrameWriter text(reinterpret_cast<char*>(arena_ + used), share,
+                         FrameOverflow::TRUNCATE);
+        e.capture_text(e, text, selection.views[i]);
+        text.Seal();
+        captured_size[i] = text.Size();
+      } else {
+        continue;
+      }
+      captured[i] = arena_ + used;
+      used += captured_size[i];
+    }
+    ctx.ProfileEnd(ProfileStage::CAPTURE, capture_begin);
+
+    if (ctx.reducer != nullptr &&
+        !ReduceCaptured(selection, *ctx.reducer, ctx.reduce_emit, captured)) {
+      return;
+    }
+
+    if (ctx.format == OutputFormat::BINARY) {
+      EmitBinary(selection, ctx, timestamp_ms, captured, used);
+      return;
+    }
+
+    // delta 模式下 Live 模块的文本整体作为一个字段比较
+    bool keyframe = ctx.BeginDeltaFrame();
+    size_t printed = 0;
+    FrameBuffer<> out;
+    out.Profile(ctx.profile);
+    out.Printf<"[%u ms] debug%s\r\n">(static_cast<unsigned>(timestamp_ms),
+                                      keyframe ? "" : " delta");
+    for (size_t i = 0; i < count_; ++i) {
+      if (captured[i] == nullptr && (skipped & (1u << i)) == 0) {
+        continue;
+      }
+      const ProviderEntry& e = entries_[i];
+      const ViewSelection& view = selection.views[i];
+      char name_buf[64];
+      out.Printf<"-- %s %s\r\n">(
+          e.name, view_selection_name(
+                      view, [&](uint8_t v) { return e.view_name(e, v); },
+                      name_buf, sizeof(name_buf)));
+      if (captured[i] == nullptr) {
+        out.Write(FrameWriter::TRUNCATED_MARK, FrameWriter::TRUNCATED_MARK_LEN);
+        ++printed;
+      } else if (e.snapshot_size > 0) {
+        printed += print_structured_fields(out, e.fields, e.field_count,
+                                           captured[i], view, ctx.delta_cache,
+                                           e.field_index);
+      } else if (ctx.delta_cache == nullptr ||
+                 ctx.delta_cache->Update(captured[i], captured_size[i], false,
+                                         0.0f)) {
+        out.Write(reinterpret_cast<const char*>(captured[i]),
+                  captured_size[i]);
+        ++printed;
+      }
+    }
+    if (keyframe || printed > 0) {
+      out.Flush();
+    }
+  }
+
+ private:
+  static LiveProvider LiveOf(const ProviderEntry& e) {
+    LiveProvider provider;
+    provider.fields = static_cast<const LiveField*>(e.desc);
+    provider.field_count = e.field_count;
+    provider.self = e.self;
+    provider.module_name = e.name;
+    provider.views = e.views;
+    provider.ops = e.live_ops;
+    provider.lock = e.lock;
+    provider.unlock = e.unlock;
+    provider.field_index = e.field_index;
+    return provider;
+  }
+
+  bool Add(const ProviderEntry& entry) {
+    LibXR::Mutex::LockGuard lock_guard(mutex_);
+    if (count_ >= DEBUG_CORE_MAX_PROVIDERS || entry.name == nullptr ||
+        FindByName(entry.name, std::strlen(entry.name)) < count_) {
+      return false;
+    }
+    entries_[count_++] = entry;
+    return true;
+  }
+
+  /**
+   * @brief 降采样：累计本次抓取的 Structured 快照，输出帧时写回规约值
+   * @return bool 本次需要输出时返回 true
+   */
+  bool ReduceCaptured(const SamplerSelection& selection, Reducer& reducer,
+                      bool emit, const uint8_t* const* captured) {
+    reducer.BeginCapture();
+    for (size_t i = 0; i < count_; ++i) {
+      const ProviderEntry& e = entries_[i];
+      if (captured[i] != nullptr && e.snapshot_size > 0) {
+        reduce_add_structured(reducer, e.fields, e.field_count, captured[i],
+                              selection.views[i], e.field_index);
+      }
+    }
+    if (!emit) {
+      return false;
+    }
+    reducer.BeginOutput();
+    for (size_t i = 0; i < count_; ++i) {
+      const ProviderEntry& e = entries_[i];
+      if (captured[i] != nullptr && e.snapshot_size > 0) {
+        reduce_take_structured(reducer, e.fields, e.field_count,
+                               arena_ + (captured[i] - arena_),
+                               selection.views[i], e.field_index);
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief stats 模式：抓取选中模块并按模块累计，字段名前带模块小节
+   */
+  void SampleStats(const SamplerSelection& selection,
+                   const FrameContext& ctx) {
+    StatsAccumulator& stats = *ctx.accumulator;
+    stats.BeginSample(static_cast<uint32_t>(LibXR::Thread::GetTime()));
+    for (size_t i = 0; i < count_; ++i) {
+      if ((selection.providers & (1u << i)) == 0) {
+        continue;
+      }
+      const ProviderEntry& e = entries_[i];
+      const ViewSelection& view = selection.views[i];
+      // Live 模块的采集与累计在同一回调内完成，整体计为采集
+      const uint32_t capture_begin = ctx.ProfileBegin();
+      if (e.snapshot_size == 0) {
+        e.capture_stats(e, stats, view);
+        ctx.ProfileEnd(ProfileStage::CAPTURE, capture_begin);
+        continue;
+      }
+      e.capture(e, arena_);
+      ctx.ProfileEnd(ProfileStage::CAPTURE, capture_begin);
+      accumulate_structured_fields(stats, e.name, e.fields, e.field_count,
+                                   arena_, view, e.field_index);
+    }
+  }
+
+  size_t FindByName(const char* name, size_t len) const {
+    for (size_t i = 0; i < count_; ++i) {
+      if (std::strncmp(entries_[i].name, name, len) == 0 &&
+          entries_[i].name[len] == '\0') {
+        return i;
+      }
+    }
+    return count_;
+  }
+
+  static constexpr size_t ALIGN = alignof(std::max_align_t);
+
+  static constexpr size_t Align(size_t offset) {
+    return (offset + ALIGN - 1) & ~(ALIGN - 1);
+  }
+
+  static constexpr size_t AlignDown(size_t size) { return size & ~(ALIGN - 1); }
+
+  /// Structured SAMPLE 帧在暂存区中的缓冲：原始帧与 COBS 编码区
+  static constexpr size_t SampleFrameSize(size_t snapshot_size) {
+    const size_t raw = sample_frame_max(snapshot_size);
+    return raw + cobs_max_encoded_size(raw) + 1;
+  }
+
+  /// 单个 Structured 模块在暂存区中所需的空间：快照与其二进制帧缓冲
+  static constexpr size_t StructuredArenaSize(size_t snapshot_size) {
+    return Align(snapshot_size) + SampleFrameSize(snapshot_size);
+  }
+
+  /// 前 end 个选中的 Structured 模块中是否已有模块共用该名称池
+  bool NamePoolSent(const NamePool& names, uint32_t providers,
+                    size_t end) const {
+    for (size_t i = 0; i < end; ++i) {
+      if ((providers & (1u << i)) == 0 || entries_[i].snapshot_size == 0) {
+        continue;
+      }
+      const NamePool& other =
+          static_cast<const StructuredProviderBase*>(entries_[i].desc)->names;
+      if (other.names == names.names) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void EmitBinary(const SamplerSelection& selection, const FrameContext& ctx,
+                  uint32_t timestamp_ms, const uint8_t* const* captured,
+                  size_t used) {
+    for (size_t i = 0; i < count_; ++i) {
+      const ProviderEntry& e = entries_[i];
+      if ((selection.providers & (1u << i)) == 0 || e.snapshot_size == 0) {
+        continue;
+      }
+      uint16_t stream = crc16(e.name);
+      // 首帧放不下的模块同样发送 schema，之后的帧才能解码
+      if (ctx.sequence == 0) {
+        const NamePool& names =
+            static_cast<const StructuredProviderBase*>(e.desc)->names;
+        if (!names.Empty() && !NamePoolSent(names, selection.providers, i)) {
+          send_name_pool(names);
+        }
+        send_structured_schema(stream, e.name, e.fields, e.field_count,
+                               e.snapshot_size, e.structured_parse_view,
+                               e.structured_view_to_string, names);
+      }
+      if (captured[i] == nullptr) {
+        continue;
+      }
+
+      // 帧缓冲借用暂存区剩余空间，抓取阶段已为其预留
+      const size_t raw_capacity = sample_frame_max(e.snapshot_size);
+      const size_t offset = Align(used);
+      ASSERT(offset + SampleFrameSize(e.snapshot_size) <= sizeof(arena_));
+      BinaryFrame frame(arena_ + offset, raw_capacity,
+                        arena_ + offset + raw_capacity);
+      send_structured_sample(frame, stream, ctx.sequence, timestamp_ms,
+                             selection.views[i], e.fields, e.field_count,
+                             captured[i], e.field_index);
+    }
+  }
+
+  LibXR::Mutex mutex_;
+  ProviderEntry entries_[DEBUG_CORE_MAX_PROVIDERS];
+  size_t count_ = 0;
+  alignas(std::max_align_t) uint8_t arena_[DEBUG_CORE_SAMPLER_ARENA_SIZE];
+};
+
+}  // namespace debug_core
+
+#define DEBUG_CORE_MEMBER_TYPE(SnapshotType, member) \
+  std::remove_cvref_t<decltype(SnapshotType::member)>
+#define DEBUG_CORE_FIELD(SnapshotType, member, mask, ...)                     \
+  DEBUG_CORE_FIELD_DESC(                                                      \
+      SnapshotType, member, (mask),                                           \
+      debug_core::field_printer<DEBUG_CORE_MEMBER_TYPE(SnapshotType,          \
+                                                       member)>(),            \
+      debug_core::FieldTraits<DEBUG_CORE_MEMBER_TYPE(SnapshotType,            \
+                                                     member)>::TYPE,          \
+      -1, __VA_ARGS__)
+#define DEBUG_CORE_FIELD_PREC(SnapshotType, member, mask, precision, ...)    \
+  DEBUG_CORE_FIELD_DESC(                                                      \
+      SnapshotType, member, (mask),                                           \
+      (debug_core::field_printer<DEBUG_CORE_MEMBER_TYPE(SnapshotType,         \
+                                                        member),              \
+                                 (precision)>()),                             \
+      debug_core::FieldTraits<DEBUG_CORE_MEMBER_TYPE(SnapshotType,            \
+                                                     member)>::TYPE,          \
+      (precision), __VA_ARGS__)
+#define DEBUG_CORE_FIELD_DESC(SnapshotType, member, mask, printer, type,     \
+                              precision, ...)                               \
+  {#member,                                                                  \
+   debug_core::detail::field_u16<offsetof(SnapshotType, member)>(),          \
+   (mask), (printer), (type),                                                \
+   debug_core::detail::field_u16<sizeof(SnapshotType::member)>(),            \
+   (precision), __VA_ARGS__}
+#define DEBUG_CORE_FIELD_TYPED(SnapshotType, member, mask, printer, type, \
+                               ...)                                      \
+  DEBUG_CORE_FIELD_DESC(SnapshotType, member, (mask), (printer), (type), \
+                        -1, __VA_ARGS__)
+#define DEBUG_CORE_FIELD_CUSTOM(SnapshotType, member, mask, printer) \
+  DEBUG_CORE_FIELD_TYPED(SnapshotType, member, (mask), (printer),    \
+                         debug_core::FieldType::CUSTOM)
+#define DEBUG_CORE_FIELD_F32(SnapshotType, member, mask, ...)          \
+  DEBUG_CORE_FIELD_DESC(SnapshotType, member, (mask), nullptr,         \
+                        debug_core::FieldType::F32, -1, __VA_ARGS__)
+#define DEBUG_CORE_FIELD_BOOL(SnapshotType, member, mask)      \
+  DEBUG_CORE_FIELD_DESC(SnapshotType, member, (mask), nullptr, \
+                        debug_core::FieldType::BOOL, -1)
+#define DEBUG_CORE_FIELD_U8(SnapshotType, member, mask)        \
+  DEBUG_CORE_FIELD_DESC(SnapshotType, member, (mask), nullptr, \
+                        debug_core::FieldType::U8, -1)
+
+#define DEBUG_CORE_LIVE_DESC(OwnerType, name, mask, expr, ValueType,   \
+                             printer, type, precision, ...)          \
+  {(name), (mask), nullptr, (type),                                   \
+   +[](const void* self_ptr, void* out) {                             \
+     [[maybe_unused]] const auto* self =                              \
+         static_cast<const OwnerType*>(self_ptr);                     \
+     debug_core::detail::store_live_value<ValueType>(out, (expr));    \
+   },                                                                 \
+   (printer), (precision),                                            \
+   debug_core::detail::field_u16<sizeof(ValueType)>(), __VA_ARGS__}
+#define DEBUG_CORE_LIVE_TYPED(OwnerType, name, mask, expr, ValueType, \
+                              printer, type, ...)                     \
+  DEBUG_CORE_LIVE_DESC(OwnerType, name, (mask), expr, ValueType,      \
+                       (printer), (type), -1, __VA_ARGS__)
+#define DEBUG_CORE_LIVE_VALUE_TYPE(OwnerType, expr)                      \
+  std::remove_cvref_t<decltype([](const OwnerType* self) -> decltype(auto) { \
+    return (expr);                                                       \
+  }(nullptr))>
+#define DEBUG_CORE_LIVE(OwnerType, name, mask, expr, ...)                    \
+  DEBUG_CORE_LIVE_DESC(                                                      \
+      OwnerType, name, (mask), expr,                                         \
+      DEBUG_CORE_LIVE_VALUE_TYPE(OwnerType, expr),                           \
+      debug_core::field_printer<DEBUG_CORE_LIVE_VALUE_TYPE(OwnerType,        \
+                                                           expr)>(),         \
+      debug_core::FieldTraits<DEBUG_CORE_LIVE_VALUE_TYPE(OwnerType,          \
+                                                         expr)>::TYPE,       \
+      -1, __VA_ARGS__)
+#define DEBUG_CORE_LIVE_PREC(OwnerType, name, mask, expr, precision, ...)    \
+  DEBUG_CORE_LIVE_DESC(                                                      \
+      OwnerType, name, (mask), expr,                                         \
+      DEBUG_CORE_LIVE_VALUE_TYPE(OwnerType, expr),                           \
+      (debug_core::field_printer<DEBUG_CORE_LIVE_VALUE_TYPE(OwnerType,       \
+                                                            expr),           \
+                                 (precision)>()),                            \
+      debug_core::FieldTraits<DEBUG_CORE_LIVE_VALUE_TYPE(OwnerType,          \
+                                                         expr)>::TYPE,       \
+      (precision), __VA_ARGS__)
+#define DEBUG_CORE_LIVE_F32(OwnerType, name, mask, expr, ...)        \
+  DEBUG_CORE_LIVE_DESC(OwnerType, name, (mask), expr, float, nullptr, \
+                       debug_core::FieldType::F32, -1, __VA_ARGS__)
+#define DEBUG_CORE_LIVE_BOOL(OwnerType, name, mask, expr)            \
+  DEBUG_CORE_LIVE_DESC(OwnerType, name, (mask), expr, bool, nullptr, \
+                       debug_core::FieldType::BOOL, -1)
+#define DEBUG_CORE_LIVE_U8(OwnerType, name, mask, expr)                 \
+  DEBUG_CORE_LIVE_DESC(OwnerType, name, (mask), expr, uint8_t, nullptr, \
+                       debug_core::FieldType::U8, -1)
+#define DEBUG_CORE_LIVE_CUSTOM(OwnerType, name, mask, printer)          \
+  {(name), (mask),                                                      \
+   +[](debug_core::FrameWriter& out, const char* field_name,            \
+       const void* self) {                                              \
+     (printer)(out, field_name, static_cast<const OwnerType*>(self));   \
+   }}
+
+/**
+ * @brief DebugCore 应用模块
+ * @details 注册 `debug` 终端命令，对 debug_core::ProviderRegistry 中登记的
+ *          全部模块做时间对齐的合并采样：
+ *          `debug list`、`debug once [sel] [bin]`、
+ *          `debug monitor <time_ms> [interval_ms] [sel]
+ *          [bin|stats[:K]|delta[:K]] [sample:<ms>[:mode]] [prof] [&]`，
+ *          其中 sel 为 `all` 或 `module[.view][,module[.view]...]`。
+ */
+class DebugCore : public LibXR::Application {
+ public:
+  /**
+   * @brief 构造 DebugCore 模块
+   */
+  DebugCore(LibXR::HardwareContainer& hw, LibXR::ApplicationManager& app)
+      : cmd_file_(LibXR::RamFS::CreateFile(
+            "debug", debug_core::command_thunk<DebugCore, &DebugCore::Command>,
+            this)) {
+    auto ramfs = hw.template FindOrExit<LibXR::RamFS>({"ramfs"});
+    ramfs->Add(cmd_file_);
+    app.Register(*this);
+  }
+
+  /**
+   * @brief `debug` 命令入口
+   */
+  int Command(int argc, char** argv) {
+    auto& registry = debug_core::ProviderRegistry::Instance();
+
+    if (argc == 2 && std::strcmp(argv[1], "list") == 0) {
+      registry.PrintList();
+      return 0;
+    }
+
+    auto parse_view = [&registry](const char* arg,
+                                  debug_core::SamplerSelection* out) {
+      return registry.ParseSelection(arg, out);
+    };
+
+    auto print_usage = []() {
+      LibXR::STDIO::Printf<"Usage:\r\n">();
+      LibXR::STDIO::Printf<"  list\r\n">();
+      LibXR::STDIO::Printf<"  monitor <time_ms> [interval_ms] [sel] "
+                           "[bin|stats[:K]|delta[:K]] [sample:<ms>[:mode]] "
+                           "[prof] [&]\r\n">();
+      LibXR::STDIO::Printf<"  once [sel] [bin]\r\n">();
+      LibXR::STDIO::Printf<"  jobs | stop <id|all>\r\n">();
+      LibXR::STDIO::Printf<"  sel: all | module[.view][,module[.view]...]\r\n">();
+    };
+
+    auto print_once = [](const debug_core::SamplerSelection& selection,
+                         const debug_core::FrameContext& ctx) {
+      debug_core::ProviderRegistry::Instance().Sample(selection, ctx);
+    };
+
+    return debug_core::run_command(argc, argv, registry.All(), parse_view,
+                                   print_once, print_usage);
+  }
+
+  /**
+   * @brief 监控回调
+   */
+  void OnMonitor() override {}
+
+ private:
+  LibXR::RamFS::File cmd_file_;
+};
+
+#else
+
+#include "DebugCoreDisabled.hpp"
+
+#endif  // DEBUG_CORE_ENABLED
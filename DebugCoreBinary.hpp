@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace debug_core {
+
+/**
+ * @brief 二进制帧类型
+ */
+enum class BinaryKind : uint8_t {
+  SCHEMA_MODULE = 0x01,  ///< 模块描述：字段数、快照大小、模块名
+  SCHEMA_FIELD = 0x02,   ///< 字段描述：偏移、大小、类型、视图掩码、字段名
+  SAMPLE = 0x03,         ///< 采样数据：时间戳 + 选中字段的原始字节
+  SCHEMA_VIEW = 0x04,    ///< 视图描述：视图值、视图名
+  SCHEMA_NAME = 0x05,    ///< 名称描述：名称编号、名称（流编号为名称池编号）
+  SCHEMA_FIELD_ID = 0x06,  ///< 字段描述，以名称编号代替字段名
+  SCHEMA_VIEW_ID = 0x07,   ///< 视图描述，以名称编号代替视图名
+};
+
+/**
+ * @brief 生成 CRC-16/CCITT-FALSE 查找表
+ */
+constexpr std::array<uint16_t, 256> make_crc16_table() {
+  std::array<uint16_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint16_t crc = static_cast<uint16_t>(i << 8);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000u) ? static_cast<uint16_t>((crc << 1) ^ 0x1021u)
+                            : static_cast<uint16_t>(crc << 1);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+inline constexpr std::array<uint16_t, 256> CRC16_TABLE = make_crc16_table();
+
+/**
+ * @brief 计算 CRC-16/CCITT-FALSE（多项式 0x1021，初值 0xFFFF）
+ * @param data 数据地址
+ * @param size 数据长度
+ * @param crc 初值，可用于分段计算
+ * @return uint16_t 校验值
+ */
+constexpr uint16_t crc16(const uint8_t* data, size_t size,
+                         uint16_t crc = 0xFFFFu) {
+  for (size_t i = 0; i < size; ++i) {
+    crc = static_cast<uint16_t>((crc << 8) ^
+                                CRC16_TABLE[((crc >> 8) ^ data[i]) & 0xFFu]);
+  }
+  return crc;
+}
+
+/**
+ * @brief 计算字符串的 CRC-16，用作模块流编号
+ */
+constexpr uint16_t crc16(const char* str) {
+  uint16_t crc = 0xFFFFu;
+  for (; *str != '\0'; ++str) {
+    crc = static_cast<uint16_t>(
+        (crc << 8) ^
+        CRC16_TABLE[((crc >> 8) ^ static_cast<uint8_t>(*str)) & 0xFFu]);
+  }
+  return crc;
+}
+
+/**
+ * @brief COBS 编码后的最大长度（不含帧尾 0）
+ */
+constexpr size_t cobs_max_encoded_size(size_t size) {
+  return size + size / 254 + 1;
+}
+
+/**
+ * @brief COBS 编码
+ * @param in 原始数据
+ * @param size 原始长度
+ * @param out 输出缓冲区，至少 cobs_max_encoded_size(size) 字节
+ * @return size_t 编码后长度（不含帧尾 0）
+ */
+inline size_t cobs_encode(const uint8_t* in, size_t size, uint8_t* out) {
+  size_t code_pos = 0;
+  size_t write = 1;
+  uint8_t code = 1;
+  for (size_t read = 0; read < size; ++read) {
+    if (in[read] == 0) {
+      out[code_pos] = code;
+      code_pos = write++;
+      code = 1;
+      continue;
+    }
+    out[write++] = in[read];
+    if (++code == 0xFF) {
+      out[code_pos] = code;
+      code_pos = write++;
+      code = 1;
+    }
+  }
+  out[code_pos] = code;
+  return write;
+}
+
+/**
+ * @brief 二进制帧构建器
+ * @details 帧结构（小端）：原始内容 + CRC-16，整体 COBS 编码后以 0x00 结尾。
+ *          原始内容超出容量时该帧作废，Send() 不输出任何字节。
+ */
+class BinaryFrame {
+ public:
+  /**
+   * @brief 构造帧构建器
+   * @param raw 原始内容缓冲区
+   * @param raw_capacity 原始内容容量（含 2 字节 CRC）
+   * @param encoded 编码缓冲区，至少 cobs_max_encoded_size(raw_capacity) + 1
+   */
+  BinaryFrame(uint8_t* raw, size_t raw_capacity, uint8_t* encoded)
+      : raw_(raw), capacity_(raw_capacity), encoded_(encoded) {}
+
+  /**
+   * @brief 开始新帧并写入公共帧头
+   * @param kind 帧类型
+   * @param stream 模块流编号
+   */
+  void Begin(BinaryKind kind, uint16_t stream) {
+    size_ = 0;
+    overflow_ = false;
+    PutU8(static_cast<uint8_t>(kind));
+    PutU16(stream);
+  }
+
+  void PutU8(uint8_t value) { PutBytes(&value, sizeof(value)); }
+
+  void PutU16(uint16_t value) {
+    uint8_t bytes[2] = {static_cast<uint8_t>(value),
+                        static_cast<uint8_t>(value >> 8)};
+    PutBytes(bytes, sizeof(bytes));
+  }
+
+  void PutU32(uint32_t value) {
+    uint8_t bytes[4] = {
+        static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+        static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)};
+    PutBytes(bytes, sizeof(bytes));
+  }
+
+  /**
+   * @brief 写入带 1 字节长度前缀的字符串
+   * @param str 字符串
+   * @param max_len 最大长度，超出部分截断
+   */
+  void PutString(const char* str, size_t max_len = 0xFF) {
+    size_t len = str ? std::strlen(str) : 0;
+    if (max_len > 0xFF) {
+      max_len = 0xFF;
+    }
+    if (len > max_len) {
+      len = max_len;
+    }
+    PutU8(static_cast<uint8_t>(len));
+    PutBytes(str, len);
+  }
+
+  void PutBytes(const void* data, size_t size) {
+    if (overflow_ || size > capacity_ - 2 - size_) {
+      overflow_ = true;
+      return;
+    }
+    std::memcpy(raw_ + size_, data, size);
+    size_ += size;
+  }
+
+  /**
+   * @brief 当前帧内容是否超出容量
+   */
+  bool Overflowed() const { return overflow_; }
+
+  /**
+   * @brief 追加 CRC、COBS 编码并以单次写操作输出
+   * @tparam WriteFn 写回调类型，签名 bool(const void*, size_t)
+   * @return bool 输出成功返回 true，帧作废或写失败时返回 false
+   */
+  template <typename WriteFn>
+  bool Send(WriteFn write) {
+    if (overflow_) {
+      return false;
+    }
+    uint16_t crc = crc16(raw_, size_);
+    raw_[size_++] = static_cast<uint8_t>(crc);
+    raw_[size_++] = static_cast<uint8_t>(crc >> 8);
+    size_t len = cobs_encode(raw_, size_, encoded_);
+    encoded_[len++] = 0x00;
+    return write(encoded_, len);
+  }
+
+ private:
+  uint8_t* raw_;
+  size_t capacity_;
+  uint8_t* encoded_;
+  size_t size_ = 0;
+  bool overflow_ = false;
+};
+
+/**
+ * @brief 自带定长存储的二进制帧构建器
+ * @tparam RawCapacity 原始内容容量（含 2 字节 CRC）
+ */
+template <size_t RawCapacity>
+class BinaryFrameBuffer : public BinaryFrame {
+ public:
+  BinaryFrameBuffer() : BinaryFrame(raw_, RawCapacity, encoded_) {}
+
+ private:
+  uint8_t raw_[RawCapacity];
+  uint8_t encoded_[cobs_max_encoded_size(RawCapacity) + 1];
+};
+
+}  // namespace debug_core
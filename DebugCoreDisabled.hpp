@@ -0,0 +1,262 @@
+#pragma once
+
+// DEBUG_CORE_ENABLED 为 0 时由 DebugCore.hpp 包含，不要直接包含本文件。
+//
+// 这里的类型与函数只保留模块接入代码用到的接口形状：字段描述、提供器与命令
+// 执行器都是空类型或 constexpr 空函数，字段宏的参数只参与编译期检查（成员名、
+// 取值表达式、打印函数签名仍会被检查），不会生成任何数据或代码。
+
+namespace debug_core {
+
+/**
+ * @brief 帧格式化器桩，自定义打印函数中的调用均为空操作
+ */
+class FrameWriter {
+ public:
+  template <FormatString Fmt, typename... Args>
+  void Printf(Args...) {}
+
+  void Write(const char*, size_t) {}
+
+  void Flush() {}
+};
+
+inline void print_f32_line(FrameWriter&, const char*, float, uint8_t) {}
+inline void print_bool_field(FrameWriter&, const char*, const void*) {}
+inline void print_u8_field(FrameWriter&, const char*, const void*) {}
+inline void print_f32_field(FrameWriter&, const char*, const void*) {}
+inline void print_bool_value(FrameWriter&, const char*, bool) {}
+inline void print_u8_value(FrameWriter&, const char*, uint8_t) {}
+inline void print_f32_value(FrameWriter&, const char*, float) {}
+
+template <typename T, int Precision = -1>
+inline void print_typed_field(FrameWriter&, const char*, const void*) {}
+
+using FieldPrintFn = void (*)(FrameWriter& out, const char* name,
+                              const void* field_ptr);
+
+template <typename T, int Precision = -1>
+constexpr FieldPrintFn field_printer() {
+  return nullptr;
+}
+
+/**
+ * @brief Structured 模式字段描述桩
+ * @details 空类型，字段宏的全部参数在常量初始化时被丢弃。静态成员 view_mask
+ *          与 name 让 make_field_view_index() 与 make_name_pool() 仍可编译，
+ *          生成空索引，名称池中不含字段名。
+ */
+struct FieldDesc {
+  static constexpr ViewMask view_mask{};
+  static constexpr const char* name = nullptr;
+
+  constexpr FieldDesc() = default;
+
+  template <typename... Args>
+  constexpr FieldDesc(const Args&...) {}  // NOLINT
+};
+
+/**
+ * @brief Live 模式字段描述桩
+ */
+struct LiveField {
+  static constexpr ViewMask view_mask{};
+  static constexpr const char* name = nullptr;
+
+  constexpr LiveField() = default;
+
+  template <typename... Args>
+  constexpr LiveField(const Args&...) {}  // NOLINT
+};
+
+/**
+ * @brief Live 模式字段描述，与启用时一样是 LiveField 的别名
+ */
+template <typename Owner>
+using LiveFieldDesc = LiveField;
+
+/**
+ * @brief Live 模式提供器桩
+ */
+struct LiveProvider {};
+
+template <typename... Args>
+constexpr LiveProvider make_live_provider(const Args&...) {
+  return {};
+}
+
+/**
+ * @brief 飞行记录器桩，Record() 为空操作
+ */
+template <typename Snapshot>
+class SnapshotRecorder {
+  static_assert(std::is_trivially_copyable_v<Snapshot>,
+                "Snapshot must be trivially copyable");
+
+ public:
+  void Record(const Snapshot&) {}
+
+  void Record(const Snapshot&, uint32_t) {}
+
+  size_t Capacity() const { return 0; }
+};
+
+/**
+ * @brief 定长飞行记录器桩，不占用记录存储
+ */
+template <typename Snapshot, size_t N>
+class FlightRecorder : public SnapshotRecorder<Snapshot> {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+};
+
+/**
+ * @brief Structured 模式提供器（与快照类型无关的部分）桩
+ */
+struct StructuredProviderBase {};
+
+/**
+ * @brief Structured 模式提供器桩
+ */
+template <typename Snapshot>
+struct StructuredProvider : StructuredProviderBase {
+  template <typename... Args>
+  constexpr StructuredProvider(const Args&...) {}  // NOLINT
+};
+
+/**
+ * @brief 快照通道桩
+ * @details 生产者仍需一块可写的快照，Begin() 返回唯一的暂存缓冲区；Commit()
+ *          不发布，Read() 始终返回 false。
+ */
+template <typename Snapshot>
+class SnapshotChannel {
+  static_assert(std::is_trivially_copyable_v<Snapshot>,
+                "Snapshot must be trivially copyable");
+
+ public:
+  Snapshot& Begin() { return scratch_; }
+
+  void Commit() {}
+
+  void Publish(const Snapshot&) {}
+
+  bool Read(Snapshot*) { return false; }
+
+ private:
+  Snapshot scratch_{};
+};
+
+template <typename Owner, typename Snapshot,
+          SnapshotChannel<Snapshot> Owner::*Channel>
+void capture_from_channel(void*, Snapshot*) {}
+
+/**
+ * @brief 提供器注册表桩，Register() 不登记任何模块
+ */
+class ProviderRegistry {
+ public:
+  static ProviderRegistry& Instance() {
+    static ProviderRegistry registry;
+    return registry;
+  }
+
+  template <typename... Args>
+  constexpr bool Register(const Args&...) {
+    return false;
+  }
+};
+
+/**
+ * @brief 输出上下文桩，供接收 FrameContext 的打印回调编译
+ */
+struct FrameContext {};
+
+/**
+ * @brief 通用命令执行器桩
+ * @return int 始终返回 -1
+ */
+template <typename... Args>
+constexpr int run_command(const Args&...) {
+  return -1;
+}
+
+/**
+ * @brief Live 模式命令执行器桩
+ * @return int 始终返回 -1
+ */
+template <typename... Args>
+constexpr int run_live_command(const Args&...) {
+  return -1;
+}
+
+/**
+ * @brief Structured 模式命令执行器桩
+ * @return int 始终返回 -1
+ */
+template <typename... Args>
+constexpr int run_structured_command(const Args&...) {
+  return -1;
+}
+
+}  // namespace debug_core
+
+#define DEBUG_CORE_MEMBER_TYPE(SnapshotType, member) \
+  std::remove_cvref_t<decltype(SnapshotType::member)>
+#define DEBUG_CORE_FIELD(SnapshotType, member, mask, ...) \
+  {offsetof(SnapshotType, member), (mask), __VA_ARGS__}
+#define DEBUG_CORE_FIELD_PREC(SnapshotType, member, mask, precision, ...) \
+  {offsetof(SnapshotType, member), (mask), (precision), __VA_ARGS__}
+#define DEBUG_CORE_FIELD_DESC(SnapshotType, member, mask, printer, type, \
+                              precision, ...)                          \
+  {offsetof(SnapshotType, member), (mask), (printer), (type),           \
+   (precision), __VA_ARGS__}
+#define DEBUG_CORE_FIELD_TYPED(SnapshotType, member, mask, printer, type, \
+                               ...)                                      \
+  {offsetof(SnapshotType, member), (mask), (printer), (type), __VA_ARGS__}
+#define DEBUG_CORE_FIELD_CUSTOM(SnapshotType, member, mask, printer) \
+  {offsetof(SnapshotType, member), (mask), (printer)}
+#define DEBUG_CORE_FIELD_F32(SnapshotType, member, mask, ...) \
+  {offsetof(SnapshotType, member), (mask), __VA_ARGS__}
+#define DEBUG_CORE_FIELD_BOOL(SnapshotType, member, mask) \
+  {offsetof(SnapshotType, member), (mask)}
+#define DEBUG_CORE_FIELD_U8(SnapshotType, member, mask) \
+  {offsetof(SnapshotType, member), (mask)}
+
+/// 只做类型检查的取值表达式，调用运算符从不实例化到镜像中
+#define DEBUG_CORE_LIVE_CHECK(OwnerType, expr) \
+  []([[maybe_unused]] const OwnerType* self) { static_cast<void>(expr); }
+#define DEBUG_CORE_LIVE_DESC(OwnerType, name, mask, expr, ValueType, \
+                             printer, type, precision, ...)        \
+  {(name), (mask), DEBUG_CORE_LIVE_CHECK(OwnerType, expr), (printer), \
+   (type), (precision), __VA_ARGS__}
+#define DEBUG_CORE_LIVE_TYPED(OwnerType, name, mask, expr, ValueType, \
+                              printer, type, ...)                     \
+  {(name), (mask), DEBUG_CORE_LIVE_CHECK(OwnerType, expr), (printer),  \
+   (type), __VA_ARGS__}
+#define DEBUG_CORE_LIVE_VALUE_TYPE(OwnerType, expr)                      \
+  std::remove_cvref_t<decltype([](const OwnerType* self) -> decltype(auto) { \
+    return (expr);                                                       \
+  }(nullptr))>
+#define DEBUG_CORE_LIVE(OwnerType, name, mask, expr, ...) \
+  {(name), (mask), DEBUG_CORE_LIVE_CHECK(OwnerType, expr), __VA_ARGS__}
+#define DEBUG_CORE_LIVE_PREC(OwnerType, name, mask, expr, precision, ...) \
+  {(name), (mask), DEBUG_CORE_LIVE_CHECK(OwnerType, expr), (precision),   \
+   __VA_ARGS__}
+#define DEBUG_CORE_LIVE_F32(OwnerType, name, mask, expr, ...) \
+  {(name), (mask), DEBUG_CORE_LIVE_CHECK(OwnerType, expr), __VA_ARGS__}
+#define DEBUG_CORE_LIVE_BOOL(OwnerType, name, mask, expr) \
+  {(name), (mask), DEBUG_CORE_LIVE_CHECK(OwnerType, expr)}
+#define DEBUG_CORE_LIVE_U8(OwnerType, name, mask, expr) \
+  {(name), (mask), DEBUG_CORE_LIVE_CHECK(OwnerType, expr)}
+#define DEBUG_CORE_LIVE_CUSTOM(OwnerType, name, mask, printer) \
+  {(name), (mask), (printer)}
+
+/**
+ * @brief DebugCore 应用模块桩，不注册 `debug` 命令
+ */
+class DebugCore : public LibXR::Application {
+ public:
+  DebugCore(LibXR::HardwareContainer&, LibXR::ApplicationManager&) {}
+
+  void OnMonitor() override {}
+};
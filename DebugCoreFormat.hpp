@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace debug_core {
+
+/// format_f32() 支持的最大小数位数
+inline constexpr uint8_t F32_MAX_PRECISION = 6;
+
+/// format_f32() 的最大输出长度：符号 + 39 位整数 + 小数点 + 6 位小数
+inline constexpr size_t F32_TEXT_MAX = 1 + 39 + 1 + F32_MAX_PRECISION;
+
+namespace detail {
+
+inline constexpr uint32_t POW10_U32[] = {1u,       10u,       100u,
+                                         1000u,    10000u,    100000u,
+                                         1000000u, 10000000u, 100000000u,
+                                         1000000000u};
+
+/**
+ * @brief 无符号整数转十进制
+ * @return size_t 输出长度
+ */
+inline size_t format_u32(char* out, uint32_t value) {
+  char digits[10];
+  size_t count = 0;
+  do {
+    digits[count++] = static_cast<char>('0' + value % 10u);
+    value /= 10u;
+  } while (value != 0);
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = digits[count - 1 - i];
+  }
+  return count;
+}
+
+/**
+ * @brief 无符号整数转定宽十进制，高位补零
+ */
+inline void format_u32_fixed(char* out, uint32_t value, size_t width) {
+  for (size_t i = width; i-- > 0;) {
+    out[i] = static_cast<char>('0' + value % 10u);
+    value /= 10u;
+  }
+}
+
+/**
+ * @brief 大整数 mantissa * 2^shift 转十进制（|v| >= 2^32 的 float）
+ * @details 128 位以内按 32 位字存放，反复除以 10^9 取出 9 位一组。只在极大
+ *          值时走到，不追求速度。
+ * @return size_t 输出长度
+ */
+inline size_t format_f32_big(char* out, uint32_t mantissa, uint32_t shift) {
+  uint32_t words[5] = {};
+  uint32_t word = shift / 32u;
+  uint32_t bit = shift % 32u;
+  words[word] = mantissa << bit;
+  if (bit != 0) {
+    words[word + 1] = mantissa >> (32u - bit);
+  }
+
+  uint32_t groups[5];
+  size_t group_count = 0;
+  size_t top = word + 2;
+  while (top > 0 && words[top - 1] == 0) {
+    --top;
+  }
+  while (top > 0) {
+    uint64_t rem = 0;
+    for (size_t i = top; i-- > 0;) {
+      uint64_t cur = (rem << 32) | words[i];
+      words[i] = static_cast<uint32_t>(cur / 1000000000u);
+      rem = cur % 1000000000u;
+    }
+    groups[group_count++] = static_cast<uint32_t>(rem);
+    while (top > 0 && words[top - 1] == 0) {
+      --top;
+    }
+  }
+
+  size_t len = format_u32(out, groups[group_count - 1]);
+  for (size_t i = group_count - 1; i-- > 0;) {
+    format_u32_fixed(out + len, groups[i], 9);
+    len += 9;
+  }
+  return len;
+}
+
+}  // namespace detail
+
+/// format_u64() / format_i64() 的最大输出长度
+inline constexpr size_t INT_TEXT_MAX = 20;
+
+/**
+ * @brief 无符号整数转十进制，32 位以内只做 32 位除法
+ * @param out 输出缓冲区，至少 INT_TEXT_MAX 字节，不写结尾 0
+ * @return size_t 输出长度
+ */
+inline size_t format_u64(char* out, uint64_t value) {
+  if (value <= 0xFFFFFFFFu) {
+    return detail::format_u32(out, static_cast<uint32_t>(value));
+  }
+  uint32_t low = static_cast<uint32_t>(value % 1000000000u);
+  size_t len = format_u64(out, value / 1000000000u);
+  detail::format_u32_fixed(out + len, low, 9);
+  return len + 9;
+}
+
+/**
+ * @brief 有符号整数转十进制
+ * @param out 输出缓冲区，至少 INT_TEXT_MAX 字节，不写结尾 0
+ * @return size_t 输出长度
+ */
+inline size_t format_i64(char* out, int64_t value) {
+  if (value < 0) {
+    out[0] = '-';
+    return 1 + format_u64(out + 1, 0u - static_cast<uint64_t>(value));
+  }
+  return format_u64(out, static_cast<uint64_t>(value));
+}
+
+/**
+ * @brief float 定点格式化，输出与 printf("%.*f") 逐字节一致
+ * @details 直接按 IEEE-754 位模式做整数运算，不经过 double 和 libc：
+ *          - |v| < 2^24 时小数部分为 frac * 10^p / 2^k 的精确值，用一次 64 位
+ *            乘法和移位求出，余数按最近偶数舍入，进位传到整数部分；
+ *          - 更大的值本身是整数，小数位补零；
+ *          - NaN / Inf 输出 nan / inf，负数（含 -0）带 '-'。
+ * @param out 输出缓冲区，至少 F32_TEXT_MAX 字节，不写结尾 0
+ * @param value 数值
+ * @param precision 小数位数，超过 F32_MAX_PRECISION 时按 F32_MAX_PRECISION
+ * @return size_t 输出长度
+ */
+inline size_t format_f32(char* out, float value, uint8_t precision) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  size_t len = 0;
+  if ((bits >> 31) != 0) {
+    out[len++] = '-';
+  }
+
+  uint32_t exponent = (bits >> 23) & 0xFFu;
+  uint32_t mantissa = bits & 0x7FFFFFu;
+  if (exponent == 0xFFu) {
+    std::memcpy(out + len, mantissa != 0 ? "nan" : "inf", 3);
+    return len + 3;
+  }
+  if (precision > F32_MAX_PRECISION) {
+    precision = F32_MAX_PRECISION;
+  }
+
+  // value = mantissa * 2^(exponent - 150)，非规格化数指数固定为 -149
+  int32_t shift = -149;
+  if (exponent != 0) {
+    mantissa |= 0x800000u;
+    shift = static_cast<int32_t>(exponent) - 150;
+  }
+
+  uint32_t int_part = 0;
+  uint32_t frac_part = 0;
+  if (shift > 8) {
+    len += detail::format_f32_big(out + len, mantissa,
+                                  static_cast<uint32_t>(shift));
+  } else {
+    if (shift >= 0) {
+      int_part = mantissa << shift;
+    } else if (shift > -64) {
+      // 小于 2^-40 的值在 6 位小数内恒舍入为 0
+      uint32_t k = static_cast<uint32_t>(-shift);
+      uint64_t frac_bits = mantissa;
+      if (k < 32) {
+        int_part = mantissa >> k;
+        frac_bits = mantissa & ((1u << k) - 1u);
+      }
+      uint64_t scaled = frac_bits * detail::POW10_U32[precision];
+      uint64_t quotient = scaled >> k;
+      uint64_t remainder = scaled & ((uint64_t{1} << k) - 1u);
+      uint64_t half = uint64_t{1} << (k - 1);
+      uint64_t last = precision != 0 ? quotient : int_part;
+      if (remainder > half || (remainder == half && (last & 1u) != 0)) {
+        ++quotient;
+      }
+      frac_part = static_cast<uint32_t>(quotient);
+      if (frac_part == detail::POW10_U32[precision]) {
+        frac_part = 0;
+        ++int_part;
+      }
+    }
+    len += detail::format_u32(out + len, int_part);
+  }
+
+  if (precision != 0) {
+    out[len++] = '.';
+    detail::format_u32_fixed(out + len, frac_part, precision);
+    len += precision;
+  }
+  return len;
+}
+
+}  // namespace debug_core
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "DebugCoreBinary.hpp"
+#include "DebugCoreView.hpp"
+
+namespace debug_core {
+
+/**
+ * @brief 名称池中不存在的名称编号
+ */
+inline constexpr uint16_t NAME_NONE = 0xFFFF;
+
+/**
+ * @brief 类型擦除的共享名称池
+ * @details 按编号保存去重后的字段名、视图名与模块名。池中只存放指向原字符串
+ *          字面量的指针，相同的字面量由链接器合并为一份，名称池本身不再复制
+ *          字符。names 为空表示未提供名称池。由 make_name_pool() 生成。
+ */
+struct NamePool {
+  const char* const* names = nullptr;
+  uint16_t count = 0;
+  uint16_t id = 0;  ///< 名称池编号，二进制 schema 中名称帧的流编号
+
+  constexpr bool Empty() const { return names == nullptr; }
+
+  constexpr uint16_t Size() const { return count; }
+
+  /**
+   * @brief 根据编号获取名称
+   * @return const char* 名称，编号越界时返回 nullptr
+   */
+  constexpr const char* Name(uint16_t name_id) const {
+    return name_id < count ? names[name_id] : nullptr;
+  }
+
+  /**
+   * @brief 查找名称编号
+   * @details 运行期先比较指针（同一字面量），再比较内容；可在编译期调用。
+   * @return uint16_t 名称编号，不在池中时返回 NAME_NONE
+   */
+  constexpr uint16_t Find(const char* name) const {
+    if (name == nullptr) {
+      return NAME_NONE;
+    }
+    if (!std::is_constant_evaluated()) {
+      for (uint16_t i = 0; i < count; ++i) {
+        if (names[i] == name) {
+          return i;
+        }
+      }
+    }
+    for (uint16_t i = 0; i < count; ++i) {
+      if (detail::view_str_equal(names[i], name)) {
+        return i;
+      }
+    }
+    return NAME_NONE;
+  }
+};
+
+/**
+ * @brief 名称池的定长存储
+ * @tparam N 去重后的名称数
+ */
+template <size_t N>
+struct NamePoolTable {
+  const char* names[N == 0 ? 1 : N] = {};
+  uint16_t id = 0;
+
+  constexpr operator NamePool() const {
+    return {N == 0 ? nullptr : names, static_cast<uint16_t>(N), id};
+  }
+
+  constexpr uint16_t Find(const char* name) const {
+    return NamePool(*this).Find(name);
+  }
+};
+
+namespace detail {
+
+template <size_t Capacity>
+struct NameList {
+  std::array<const char*, Capacity> names{};
+  size_t count = 0;
+
+  constexpr void Add(const char* name) {
+    if (name == nullptr) {
+      return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (view_str_equal(names[i], name)) {
+        return;
+      }
+    }
+    names[count++] = name;
+  }
+};
+
+constexpr const char* pool_entry_name(const char* name) { return name; }
+
+template <typename Entry>
+constexpr const char* pool_entry_name(const Entry& entry) {
+  return entry.name;
+}
+
+template <const auto&... Tables>
+consteval auto collect_pool_names() {
+  NameList<(std::size(Tables) + ... + size_t{0})> list;
+  (
+      [&] {
+        for (const auto& entry : Tables) {
+          list.Add(pool_entry_name(entry));
+        }
+      }(),
+      ...);
+  return list;
+}
+
+}  // namespace detail
+
+/**
+ * @brief 由若干名称表在编译期生成去重的共享名称池
+ * @details 接受 FieldDesc / LiveFieldDesc 字段表、ViewEntry 视图表和
+ *          `const char*` 名称数组（如模块名），按出现顺序编号，相同内容的名称
+ *          只保留一份。各表需为具有静态存储期的 constexpr 数组。多个模块共用
+ *          一个名称池时，二进制 schema 在一次会话中只发送一次名称，字段与视图
+ *          描述只携带 2 字节名称编号。
+ * @code
+ * static constexpr const char* MODULES[] = {"gimbal", "chassis"};
+ * inline constexpr auto NAMES = debug_core::make_name_pool<
+ *     MODULES, Gimbal::VIEW_TABLE, Gimbal::FIELDS, Chassis::FIELDS>();
+ * static_assert(NAMES.Find("state") != debug_core::NAME_NONE);
+ * @endcode
+ */
+template <const auto&... Tables>
+consteval auto make_name_pool() {
+  constexpr auto LIST = detail::collect_pool_names<Tables...>();
+  static_assert(LIST.count < NAME_NONE, "name pool too large");
+
+  NamePoolTable<LIST.count> pool{};
+  // 名称池编号：全部名称（含结尾 0）的 CRC-16，0 保留表示“无名称池”
+  uint16_t crc = 0xFFFFu;
+  for (size_t i = 0; i < LIST.count; ++i) {
+    pool.names[i] = LIST.names[i];
+    for (const char* p = LIST.names[i];; ++p) {
+      crc = static_cast<uint16_t>(
+          (crc << 8) ^
+          CRC16_TABLE[((crc >> 8) ^ static_cast<uint8_t>(*p)) & 0xFFu]);
+      if (*p == '\0') {
+        break;
+      }
+    }
+  }
+  pool.id = crc == 0 ? 1 : crc;
+  return pool;
+}
+
+}  // namespace debug_core
@@ -0,0 +1,686 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief 视图掩码位数，即视图值上限（向上取整到 32 的倍数，不超过 256）
+ * @details 所有编译单元需一致，建议通过 CMake 缓存变量设置。
+ */
+#ifndef DEBUG_CORE_MAX_VIEWS
+#define DEBUG_CORE_MAX_VIEWS 32
+#endif
+
+namespace debug_core {
+
+namespace detail {
+
+// 故意不是 constexpr：编译期构造掩码时视图值越界即编译失败；运行期为空操作
+inline void view_mask_error_view_out_of_range() {}
+
+}  // namespace detail
+
+/**
+ * @brief 定长视图掩码
+ * @details 按 32 位字存储，位 v 表示视图 v。超出位数的视图在编译期构造时报错，
+ *          运行期得到空掩码（不再有移位越界的未定义行为）。
+ * @tparam Bits 视图数，向上取整到 32 的倍数
+ */
+template <size_t Bits>
+class BasicViewMask {
+  static_assert(Bits > 0 && Bits <= 256, "view mask supports 1..256 views");
+
+ public:
+  static constexpr size_t BITS = (Bits + 31) / 32 * 32;
+  static constexpr size_t WORDS = BITS / 32;
+  static constexpr size_t BYTES = WORDS * 4;  ///< 二进制 schema 中的字节数
+
+  constexpr BasicViewMask() = default;
+
+  /**
+   * @brief 由低 32 位构造，兼容整数掩码写法
+   */
+  constexpr BasicViewMask(uint32_t low) : words_{low} {}
+
+  static constexpr BasicViewMask Bit(size_t view) {
+    BasicViewMask mask;
+    if (view >= BITS) {
+      if (std::is_constant_evaluated()) {
+        detail::view_mask_error_view_out_of_range();
+      }
+      return mask;
+    }
+    mask.words_[view / 32] = 1u << (view % 32);
+    return mask;
+  }
+
+  static constexpr BasicViewMask All() {
+    BasicViewMask mask;
+    for (auto& w : mask.words_) {
+      w = ~uint32_t{0};
+    }
+    return mask;
+  }
+
+  constexpr bool Test(size_t view) const {
+    return view < BITS && ((words_[view / 32] >> (view % 32)) & 1u) != 0;
+  }
+
+  constexpr bool Any() const {
+    for (auto w : words_) {
+      if (w != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  constexpr bool Intersects(const BasicViewMask& other) const {
+    for (size_t i = 0; i < WORDS; ++i) {
+      if ((words_[i] & other.words_[i]) != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  constexpr size_t Count() const {
+    size_t count = 0;
+    for (auto w : words_) {
+      for (; w != 0; w &= w - 1) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  constexpr uint32_t Word(size_t index) const { return words_[index]; }
+
+  constexpr BasicViewMask& operator|=(const BasicViewMask& other) {
+    for (size_t i = 0; i < WORDS; ++i) {
+      words_[i] |= other.words_[i];
+    }
+    return *this;
+  }
+
+  friend constexpr BasicViewMask operator|(BasicViewMask a,
+                                           const BasicViewMask& b) {
+    return a |= b;
+  }
+
+  friend constexpr BasicViewMask operator&(BasicViewMask a,
+                                           const BasicViewMask& b) {
+    for (size_t i = 0; i < WORDS; ++i) {
+      a.words_[i] &= b.words_[i];
+    }
+    return a;
+  }
+
+  friend constexpr bool operator==(const BasicViewMask&,
+                                   const BasicViewMask&) = default;
+
+ private:
+  uint32_t words_[WORDS] = {};
+};
+
+using ViewMask = BasicViewMask<DEBUG_CORE_MAX_VIEWS>;
+
+/**
+ * @brief 根据视图编号生成掩码位
+ * @param view 视图编号，需小于 ViewMask::BITS
+ * @return ViewMask 视图掩码
+ */
+constexpr ViewMask view_bit(uint8_t view) { return ViewMask::Bit(view); }
+
+/**
+ * @brief 视图选择：单个视图，或用 `+` 连接的多个视图的并集
+ */
+struct ViewSelection {
+  ViewMask mask;       ///< 所选视图位的并集
+  uint8_t view = 0;    ///< 第一个所选视图，单视图时即所选视图
+  bool full = false;   ///< 包含默认（full）视图，选择全部字段
+  bool multi = false;  ///< 由多个不同视图组成
+
+  /**
+   * @brief 单视图选择
+   */
+  static constexpr ViewSelection Of(uint8_t view, uint8_t default_view) {
+    return {view_bit(view), view, view == default_view, false};
+  }
+};
+
+/**
+ * @brief 解析视图选择 `view[+view...]`
+ * @param default_view 默认（full）视图，选中时选择全部字段
+ * @param parse_one 单视图解析回调，签名 bool(const char*, uint8_t*)
+ * @return bool 每一项都是已知视图时返回 true
+ */
+template <typename ParseOneFn>
+bool parse_view_selection(const char* arg, uint8_t default_view,
+                          ParseOneFn&& parse_one, ViewSelection* out) {
+  if (arg == nullptr || out == nullptr) {
+    return false;
+  }
+  ViewSelection selection;
+  bool first = true;
+  const char* token = arg;
+  for (;;) {
+    const char* end = std::strchr(token, '+');
+    uint8_t view = 0;
+    if (end == nullptr && first) {
+      // 单视图不拷贝，视图名长度不受限
+      if (!parse_one(token, &view)) {
+        return false;
+      }
+    } else {
+      char name[32];
+      size_t len = end ? static_cast<size_t>(end - token) : std::strlen(token);
+      if (len == 0 || len >= sizeof(name)) {
+        return false;
+      }
+      std::memcpy(name, token, len);
+      name[len] = '\0';
+      if (!parse_one(name, &view)) {
+        return false;
+      }
+    }
+    if (view >= ViewMask::BITS) {
+      return false;
+    }
+    if (first) {
+      selection.view = view;
+      first = false;
+    }
+    selection.mask |= view_bit(view);
+    selection.full = selection.full || view == default_view;
+    if (end == nullptr) {
+      break;
+    }
+    token = end + 1;
+  }
+  selection.multi = selection.mask.Count() > 1;
+  *out = selection;
+  return true;
+}
+
+/**
+ * @brief 视图选择的显示名，多视图时以 `+` 连接
+ * @param name 单视图名称回调，签名 const char*(uint8_t)
+ * @param buf 多视图时的拼接缓冲区，过短时截断
+ */
+template <typename NameFn>
+const char* view_selection_name(const ViewSelection& selection, NameFn&& name,
+                                char* buf, size_t size) {
+  if (!selection.multi) {
+    return name(selection.view);
+  }
+  size_t len = 0;
+  buf[0] = '\0';
+  for (size_t v = 0; v < ViewMask::BITS; ++v) {
+    if (!selection.mask.Test(v)) {
+      continue;
+    }
+    const char* part = name(static_cast<uint8_t>(v));
+    size_t part_len = std::strlen(part);
+    size_t need = part_len + (len > 0 ? 1 : 0);
+    if (len + need >= size) {
+      break;
+    }
+    if (len > 0) {
+      buf[len++] = '+';
+    }
+    std::memcpy(buf + len, part, part_len + 1);
+    len += part_len;
+  }
+  return buf;
+}
+
+
+/**
+ * @brief 视图名称与视图值映射项
+ * @tparam View 视图值类型
+ */
+template <typename View>
+struct ViewEntry {
+  const char* name;
+  View view;
+};
+
+/**
+ * @brief 按视图表解析视图名
+ * @tparam View 视图值类型
+ * @tparam N 视图表大小
+ * @param arg 视图字符串
+ * @param table 视图映射表
+ * @param out 输出视图值
+ * @return bool 解析成功返回 true
+ */
+template <typename View, size_t N>
+bool parse_view_table(const char* arg,
+                      const std::array<ViewEntry<View>, N>& table, View* out) {
+  if (arg == nullptr || out == nullptr) {
+    return false;
+  }
+  for (const auto& item : table) {
+    if (std::strcmp(arg, item.name) == 0) {
+      *out = item.view;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 解析 uint8_t 视图名
+ * @tparam N 视图表大小
+ * @param arg 视图字符串
+ * @param table 视图映射表
+ * @param out 输出视图值
+ * @return bool 解析成功返回 true
+ */
+template <size_t N>
+bool parse_view_name(const char* arg,
+                     const std::array<ViewEntry<uint8_t>, N>& table,
+                     uint8_t* out) {
+  return parse_view_table(arg, table, out);
+}
+
+/**
+ * @brief 根据视图值获取视图名
+ * @tparam N 视图表大小
+ * @param view 视图值
+ * @param table 视图映射表
+ * @param fallback 未找到时返回值
+ * @return const char* 视图名字符串
+ */
+template <size_t N>
+const char* view_name(uint8_t view,
+                      const std::array<ViewEntry<uint8_t>, N>& table,
+                      const char* fallback = "unknown") {
+  for (const auto& item : table) {
+    if (item.view == view) {
+      return item.name;
+    }
+  }
+  return fallback;
+}
+
+/**
+ * @brief 视图表所需的掩码位数（最大视图值 + 1）
+ * @code
+ * static_assert(debug_core::view_mask_bits(VIEW_TABLE) <= debug_core::ViewMask::BITS);
+ * using ModuleMask = debug_core::BasicViewMask<debug_core::view_mask_bits(VIEW_TABLE)>;
+ * @endcode
+ */
+template <typename View, size_t N>
+constexpr size_t view_mask_bits(const std::array<ViewEntry<View>, N>& table) {
+  size_t bits = 1;
+  for (const auto& item : table) {
+    if (static_cast<size_t>(item.view) + 1 > bits) {
+      bits = static_cast<size_t>(item.view) + 1;
+    }
+  }
+  return bits;
+}
+
+namespace detail {
+
+/**
+ * @brief FNV-1a 字符串哈希，编译期与运行期结果一致
+ */
+constexpr uint32_t view_hash_name(const char* str) {
+  uint32_t hash = 2166136261u;
+  for (; *str != '\0'; ++str) {
+    hash = (hash ^ static_cast<uint8_t>(*str)) * 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief 二级哈希：以位移量扰动一级哈希（murmur3 fmix32）
+ */
+constexpr uint32_t view_hash_mix(uint32_t hash, uint32_t displacement) {
+  hash ^= displacement * 0x9E3779B9u;
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+constexpr bool view_str_equal(const char* a, const char* b) {
+  for (; *a != '\0' && *a == *b; ++a, ++b) {
+  }
+  return *a == *b;
+}
+
+constexpr size_t view_bit_ceil(size_t n) {
+  size_t result = 1;
+  while (result < n) {
+    result <<= 1;
+  }
+  return result;
+}
+
+// 以下函数故意不是 constexpr：编译期构建视图查找表时执行到它们即编译失败，
+// 报错信息中的函数名即为失败原因。
+void view_table_error_duplicate_name();
+void view_table_error_duplicate_value();
+void view_table_error_no_perfect_hash();
+void view_table_error_view_exceeds_mask();
+
+}  // namespace detail
+
+/**
+ * @brief 编译期构建的视图完美哈希查找表
+ * @details 名称→值使用 CHD（hash and displace）完美哈希表：一级哈希选桶，
+ *          桶内位移量决定二级哈希，二级哈希直接落到唯一槽位，运行期为一次
+ *          字符串哈希、两次查表和一次 strcmp，与视图数量无关。值→名称在所有
+ *          视图值都小于槽位数时（常见的连续枚举）直接按值索引，否则同样使用
+ *          CHD。重复的视图名或视图值、超出 ViewMask 位数的视图值在编译期
+ *          报错。
+ * @tparam View 视图值类型
+ * @tparam N 视图数量
+ */
+template <typename View, size_t N>
+class ViewLookup {
+  static_assert(N > 0 && N < 0xFF, "view table size must be in [1, 254]");
+
+ public:
+  static constexpr size_t BUCKETS = detail::view_bit_ceil(N);
+  static constexpr size_t SLOTS = detail::view_bit_ceil(N * 2);
+
+  consteval explicit ViewLookup(const std::array<ViewEntry<View>, N>& entries)
+      : entries_(entries) {
+    uint32_t name_hash[N] = {};
+    uint32_t value_hash[N] = {};
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < i; ++j) {
+        if (detail::view_str_equal(entries[i].name, entries[j].name)) {
+          detail::view_table_error_duplicate_name();
+        }
+        if (entries[i].view == entries[j].view) {
+          detail::view_table_error_duplicate_value();
+        }
+      }
+      if (static_cast<size_t>(entries[i].view) >= ViewMask::BITS) {
+        detail::view_table_error_view_exceeds_mask();
+      }
+      name_hash[i] = detail::view_hash_name(entries[i].name);
+      value_hash[i] = ValueHash(entries[i].view);
+      if (static_cast<uint32_t>(entries[i].view) >= SLOTS) {
+        value_direct_ = false;
+      }
+    }
+    Build(name_hash, name_disp_, name_slot_);
+    if (value_direct_) {
+      for (auto& s : value_slot_) {
+        s = EMPTY;
+      }
+      for (size_t i = 0; i < N; ++i) {
+        value_slot_[static_cast<uint32_t>(entries[i].view)] =
+            static_cast<uint8_t>(i);
+      }
+    } else {
+      Build(value_hash, value_disp_, value_slot_);
+    }
+  }
+
+  /**
+   * @brief 按名称查找视图值
+   * @return bool 找到返回 true
+   */
+  bool Parse(const char* arg, View* out) const {
+    if (arg == nullptr || out == nullptr) {
+      return false;
+    }
+    uint32_t hash = detail::view_hash_name(arg);
+    uint8_t index = name_slot_[SlotOf(hash, name_disp_)];
+    if (index == EMPTY || std::strcmp(arg, entries_[index].name) != 0) {
+      return false;
+    }
+    *out = entries_[index].view;
+    return true;
+  }
+
+  /**
+   * @brief 按视图值查找名称
+   */
+  const char* Name(View view, const char* fallback = "unknown") const {
+    uint32_t key = static_cast<uint32_t>(view);
+    size_t slot = 0;
+    if (value_direct_) {
+      if (key >= SLOTS) {
+        return fallback;
+      }
+      slot = key;
+    } else {
+      slot = SlotOf(ValueHash(view), value_disp_);
+    }
+    uint8_t index = value_slot_[slot];
+    if (index == EMPTY || !(entries_[index].view == view)) {
+      return fallback;
+    }
+    return entries_[index].name;
+  }
+
+  constexpr size_t size() const { return N; }
+  constexpr auto begin() const { return entries_.begin(); }
+  constexpr auto end() const { return entries_.end(); }
+
+ private:
+  static constexpr uint8_t EMPTY = 0xFF;
+  static constexpr uint32_t MAX_DISPLACEMENT = 0xFFFF;
+
+  static constexpr uint32_t ValueHash(View view) {
+    return detail::view_hash_mix(static_cast<uint32_t>(view), 0x5A17u);
+  }
+
+  static constexpr size_t SlotOf(uint32_t hash,
+                                 const uint16_t (&disp)[BUCKETS]) {
+    return detail::view_hash_mix(hash, disp[hash & (BUCKETS - 1)]) &
+           (SLOTS - 1);
+  }
+
+  /**
+   * @brief 按桶大小从大到小为每个桶寻找无冲突的位移量
+   */
+  static constexpr void Build(const uint32_t (&hash)[N],
+                              uint16_t (&disp)[BUCKETS],
+                              uint8_t (&slot)[SLOTS]) {
+    for (auto& s : slot) {
+      s = EMPTY;
+    }
+    size_t bucket_size[BUCKETS] = {};
+    for (size_t i = 0; i < N; ++i) {
+      ++bucket_size[hash[i] & (BUCKETS - 1)];
+    }
+
+    for (size_t size = N; size > 0; --size) {
+      for (size_t b = 0; b < BUCKETS; ++b) {
+        if (bucket_size[b] != size) {
+          continue;
+        }
+        uint32_t d = 0;
+        for (; d <= MAX_DISPLACEMENT; ++d) {
+          if (TryPlace(hash, b, static_cast<uint16_t>(d), slot)) {
+            break;
+          }
+        }
+        if (d > MAX_DISPLACEMENT) {
+          detail::view_table_error_no_perfect_hash();
+        }
+        disp[b] = static_cast<uint16_t>(d);
+      }
+    }
+  }
+
+  static constexpr bool TryPlace(const uint32_t (&hash)[N], size_t bucket,
+                                 uint16_t d, uint8_t (&slot)[SLOTS]) {
+    size_t placed[N] = {};
+    size_t count = 0;
+    for (size_t i = 0; i < N; ++i) {
+      if ((hash[i] & (BUCKETS - 1)) != bucket) {
+        continue;
+      }
+      size_t s = detail::view_hash_mix(hash[i], d) & (SLOTS - 1);
+      bool taken = slot[s] != EMPTY;
+      for (size_t k = 0; k < count && !taken; ++k) {
+        taken = placed[k] == s;
+      }
+      if (taken) {
+        // 回滚本桶已占用的槽位
+        for (size_t k = 0; k < count; ++k) {
+          slot[placed[k]] = EMPTY;
+        }
+        return false;
+      }
+      slot[s] = static_cast<uint8_t>(i);
+      placed[count++] = s;
+    }
+    return true;
+  }
+
+  std::array<ViewEntry<View>, N> entries_;
+  uint16_t name_disp_[BUCKETS] = {};
+  uint16_t value_disp_[BUCKETS] = {};
+  uint8_t name_slot_[SLOTS] = {};
+  uint8_t value_slot_[SLOTS] = {};
+  bool value_direct_ = true;  ///< 值→名称按值直接索引
+};
+
+/**
+ * @brief 由视图表构建编译期完美哈希查找表
+ * @code
+ * static constexpr std::array<debug_core::ViewEntry<uint8_t>, 3> VIEW_TABLE{
+ *     {{"state", 0}, {"pid", 1}, {"full", 2}}};
+ * static constexpr auto VIEWS = debug_core::make_view_lookup(VIEW_TABLE);
+ * @endcode
+ */
+template <typename View, size_t N>
+consteval ViewLookup<View, N> make_view_lookup(
+    const std::array<ViewEntry<View>, N>& entries) {
+  return ViewLookup<View, N>(entries);
+}
+
+template <typename View, size_t N>
+bool parse_view_table(const char* arg, const ViewLookup<View, N>& table,
+                      View* out) {
+  return table.Parse(arg, out);
+}
+
+template <size_t N>
+bool parse_view_name(const char* arg, const ViewLookup<uint8_t, N>& table,
+                     uint8_t* out) {
+  return table.Parse(arg, out);
+}
+
+template <size_t N>
+const char* view_name(uint8_t view, const ViewLookup<uint8_t, N>& table,
+                      const char* fallback = "unknown") {
+  return table.Name(view, fallback);
+}
+
+/**
+ * @brief 类型擦除的按视图字段下标索引
+ * @details 指向一段连续的 uint16_t：`[V, offsets[0..V], indices...]`。视图 v
+ *          的字段下标为 indices[offsets[v]] 到 indices[offsets[v + 1]]（不含），
+ *          按字段表顺序排列。只占一个指针，可随回调按值拷贝；data 为空表示未
+ *          提供索引，调用方回退到逐字段测试视图掩码。由 make_field_view_index()
+ *          生成。
+ */
+struct FieldViewIndex {
+  const uint16_t* data = nullptr;
+
+  constexpr bool Empty() const { return data == nullptr; }
+
+  /// 最高视图位 + 1，更大的视图不含任何字段
+  constexpr uint16_t ViewCount() const { return data[0]; }
+
+  constexpr const uint16_t* First(uint8_t view) const {
+    return data + 2 + data[0] + data[1 + view];
+  }
+
+  constexpr const uint16_t* Last(uint8_t view) const {
+    return data + 2 + data[0] + data[2 + view];
+  }
+};
+
+/**
+ * @brief 按视图字段下标索引的定长存储
+ * @tparam V 视图数
+ * @tparam T 所有视图的字段下标总数
+ */
+template <size_t V, size_t T>
+struct FieldViewIndexTable {
+  uint16_t data[2 + V + T] = {};
+
+  constexpr operator FieldViewIndex() const { return {data}; }
+};
+
+namespace detail {
+
+template <typename Fields>
+constexpr size_t field_view_count(const Fields& fields) {
+  size_t count = 0;
+  for (const auto& f : fields) {
+    for (size_t v = 0; v < ViewMask::BITS; ++v) {
+      if (f.view_mask.Test(v) && v + 1 > count) {
+        count = v + 1;
+      }
+    }
+  }
+  return count;
+}
+
+template <typename Fields>
+constexpr size_t field_view_total(const Fields& fields) {
+  size_t total = 0;
+  for (const auto& f : fields) {
+    total += f.view_mask.Count();
+  }
+  return total;
+}
+
+}  // namespace detail
+
+/**
+ * @brief 由字段表在编译期生成按视图的字段下标索引
+ * @details 适用于 FieldDesc 与 LiveFieldDesc 表。打印、采集、统计和降采样时
+ *          只遍历所选视图自己的字段下标，不再逐字段测试视图掩码。字段表需为
+ *          具有静态存储期的 constexpr 数组，索引只能与生成它的字段表一起使用。
+ * @code
+ * static constexpr debug_core::FieldDesc FIELDS[] = {...};
+ * static constexpr auto FIELD_INDEX = debug_core::make_field_view_index<FIELDS>();
+ * @endcode
+ */
+template <const auto& Fields>
+consteval auto make_field_view_index() {
+  constexpr size_t N = std::size(Fields);
+  constexpr size_t V = detail::field_view_count(Fields);
+  constexpr size_t T = detail::field_view_total(Fields);
+  static_assert(N <= 0xFFFF && T <= 0xFFFF, "field table too large");
+
+  FieldViewIndexTable<V, T> table{};
+  uint16_t* offsets = table.data + 1;
+  uint16_t* indices = table.data + 2 + V;
+  table.data[0] = static_cast<uint16_t>(V);
+  size_t used = 0;
+  for (size_t v = 0; v < V; ++v) {
+    offsets[v] = static_cast<uint16_t>(used);
+    for (size_t i = 0; i < N; ++i) {
+      if (Fields[i].view_mask.Test(v)) {
+        indices[used++] = static_cast<uint16_t>(i);
+      }
+    }
+  }
+  offsets[V] = static_cast<uint16_t>(used);
+  return table;
+}
+
+}  // namespace debug_core
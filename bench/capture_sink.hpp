@@ -0,0 +1,66 @@
+// 主机基准共用的标准输出捕获：测量期间把标准输出重定向到临时文件，按文件
+// 偏移统计写入的字节数，输出本身不再经过终端。
+
+#pragma once
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+namespace debug_core_bench {
+
+/**
+ * @brief 捕获标准输出的临时文件
+ */
+class CaptureSink {
+ public:
+  CaptureSink() {
+    std::fflush(stdout);
+    saved_ = dup(STDOUT_FILENO);
+    file_ = std::tmpfile();
+    if (saved_ < 0 || file_ == nullptr ||
+        dup2(fileno(file_), STDOUT_FILENO) < 0) {
+      std::fprintf(stderr, "capture sink setup failed\n");
+      std::exit(1);
+    }
+  }
+
+  ~CaptureSink() {
+    std::fflush(stdout);
+    dup2(saved_, STDOUT_FILENO);
+    close(saved_);
+    std::fclose(file_);
+  }
+
+  CaptureSink(const CaptureSink&) = delete;
+  CaptureSink& operator=(const CaptureSink&) = delete;
+
+  /**
+   * @brief 丢弃已捕获的输出，字节计数归零
+   */
+  void Reset() {
+    std::fflush(stdout);
+    if (ftruncate(STDOUT_FILENO, 0) != 0) {
+      std::fprintf(stderr, "capture sink truncate failed\n");
+    }
+    lseek(STDOUT_FILENO, 0, SEEK_SET);
+  }
+
+  /**
+   * @brief 自上次 Reset() 以来写入的字节数
+   */
+  size_t Bytes() {
+    std::fflush(stdout);
+    off_t offset = lseek(STDOUT_FILENO, 0, SEEK_CUR);
+    return offset < 0 ? 0 : static_cast<size_t>(offset);
+  }
+
+ private:
+  int saved_ = -1;
+  FILE* file_ = nullptr;
+};
+
+}  // namespace debug_core_bench
@@ -0,0 +1,311 @@
+// 命令路径基准：在 libxr Linux 平台上测量 run_command 参数解析，以及
+// run_live_command / run_structured_command 单帧输出的耗时、字节数与堆分配，
+// 视图大小分别为 4、32、128 个字段。在主机上构建运行：
+// cmake -DDEBUG_CORE_BUILD_BENCH=ON ...
+//
+// STDIO 仍走 libxr 的 Linux 输出端口，测量期间把标准输出重定向到临时文件，
+// 按文件偏移统计每帧字节数；堆分配按全局 operator new 计数。结果写到 stderr。
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "DebugCore.hpp"
+#include "capture_sink.hpp"
+#include "libxr.hpp"
+
+namespace {
+
+std::atomic<size_t> g_allocations{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return ::operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+constexpr uint8_t VIEW_STATE = 0;
+constexpr uint8_t VIEW_CTRL = 1;
+constexpr uint8_t VIEW_FULL = 2;
+
+constexpr std::array<debug_core::ViewEntry<uint8_t>, 3> VIEW_TABLE{{
+    {"state", VIEW_STATE},
+    {"ctrl", VIEW_CTRL},
+    {"full", VIEW_FULL},
+}};
+
+// 防止编译器把解析结果优化掉
+volatile uint32_t g_sink = 0;
+
+/// 每种情形至少运行的时间
+constexpr auto MIN_DURATION = std::chrono::milliseconds(200);
+
+using debug_core_bench::CaptureSink;
+
+struct Result {
+  double ns_per_frame;
+  double bytes_per_frame;
+  double allocs_per_frame;
+};
+
+template <typename Fn>
+Result measure(CaptureSink& sink, Fn fn) {
+  fn();  // 预热：首次调用时的静态初始化与 STDIO 互斥锁分配不计入
+  sink.Reset();
+  size_t allocs_before = g_allocations.load();
+  size_t frames = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto now = start;
+  do {
+    for (int i = 0; i < 64; ++i) {
+      fn();
+    }
+    frames += 64;
+    now = std::chrono::steady_clock::now();
+  } while (now - start < MIN_DURATION);
+  double elapsed =
+      std::chrono::duration<double, std::nano>(now - start).count();
+  size_t allocs = g_allocations.load() - allocs_before;
+  size_t bytes = sink.Bytes();
+  sink.Reset();
+  return {elapsed / static_cast<double>(frames),
+          static_cast<double>(bytes) / static_cast<double>(frames),
+          static_cast<double>(allocs) / static_cast<double>(frames)};
+}
+
+void report(const char* label, size_t fields, const Result& r) {
+  if (fields == 0) {
+    std::fprintf(stderr, "%-28s %6s %10.1f %9s %12.1f %13.2f\n", label, "-",
+                 r.ns_per_frame, "-", r.bytes_per_frame, r.allocs_per_frame);
+    return;
+  }
+  std::fprintf(stderr, "%-28s %6zu %10.1f %9.2f %12.1f %13.2f\n", label,
+               fields, r.ns_per_frame,
+               r.ns_per_frame / static_cast<double>(fields), r.bytes_per_frame,
+               r.allocs_per_frame);
+}
+
+/// 以可写副本传给命令执行器，与终端传入的 argv 一致
+template <size_t N>
+struct Args {
+  template <typename... Strings>
+  explicit Args(Strings... args) {
+    const char* list[] = {args...};
+    for (size_t i = 0; i < N; ++i) {
+      std::snprintf(storage[i], sizeof(storage[i]), "%s", list[i]);
+      argv[i] = storage[i];
+    }
+  }
+
+  int argc() const { return static_cast<int>(N); }
+
+  char storage[N][16];
+  char* argv[N];
+};
+
+template <typename... Strings>
+Args(Strings...) -> Args<sizeof...(Strings)>;
+
+// 字段 i 占快照中的第 i 个 4 字节槽，类型依次轮换 F32 / I32 / U16 / BOOL，
+// 奇偶字段分属 state 与 ctrl 视图，full 视图输出全部字段
+constexpr debug_core::FieldType field_type(size_t i) {
+  constexpr debug_core::FieldType TYPES[] = {
+      debug_core::FieldType::F32, debug_core::FieldType::I32,
+      debug_core::FieldType::U16, debug_core::FieldType::BOOL};
+  return TYPES[i % 4];
+}
+
+constexpr uint16_t field_size(size_t i) {
+  constexpr uint16_t SIZES[] = {4, 4, 2, 1};
+  return SIZES[i % 4];
+}
+
+constexpr debug_core::ViewMask field_mask(size_t i) {
+  return debug_core::view_bit(i % 2 == 0 ? VIEW_STATE : VIEW_CTRL);
+}
+
+template <size_t N>
+struct FieldNames {
+  char names[N][8] = {};
+};
+
+template <size_t N>
+constexpr FieldNames<N> make_field_names() {
+  FieldNames<N> out{};
+  for (size_t i = 0; i < N; ++i) {
+    out.names[i][0] = 'f';
+    out.names[i][1] = static_cast<char>('0' + i / 100);
+    out.names[i][2] = static_cast<char>('0' + i / 10 % 10);
+    out.names[i][3] = static_cast<char>('0' + i % 10);
+  }
+  return out;
+}
+
+template <size_t N>
+struct BenchSnapshot {
+  uint32_t slots[N];
+};
+
+template <size_t N>
+class BenchModule {
+ public:
+  using Snapshot = BenchSnapshot<N>;
+
+  static constexpr FieldNames<N> NAMES = make_field_names<N>();
+
+  BenchModule() {
+    for (size_t i = 0; i < N; ++i) {
+      float f = static_cast<float>(i) * 1.25f - 3.5f;
+      int32_t s = static_cast<int32_t>(i * 37) - 1000;
+      uint16_t u = static_cast<uint16_t>(i * 311);
+      bool b = (i / 4) % 2 == 0;
+      switch (i % 4) {
+        case 0:
+          std::memcpy(&snapshot_.slots[i], &f, sizeof(f));
+          break;
+        case 1:
+          std::memcpy(&snapshot_.slots[i], &s, sizeof(s));
+          break;
+        case 2:
+          std::memcpy(&snapshot_.slots[i], &u, sizeof(u));
+          break;
+        default:
+          std::memcpy(&snapshot_.slots[i], &b, sizeof(b));
+          break;
+      }
+    }
+  }
+
+  int Live(int argc, char** argv) {
+    return debug_core::run_live_command(this, "bench", "state|ctrl",
+                                        VIEW_TABLE, LIVE_FIELDS.data(), N,
+                                        argc, argv, VIEW_FULL);
+  }
+
+  int Structured(int argc, char** argv) {
+    return debug_core::run_structured_command(this, PROVIDER, argc, argv,
+                                              VIEW_FULL);
+  }
+
+ private:
+  template <size_t I>
+  static void Read(const void* self, void* out) {
+    std::memcpy(out, &static_cast<const BenchModule*>(self)->snapshot_.slots[I],
+                field_size(I));
+  }
+
+  template <size_t... I>
+  static constexpr std::array<debug_core::FieldDesc, N> MakeFields(
+      std::index_sequence<I...>) {
+    return {{debug_core::FieldDesc(
+        NAMES.names[I], static_cast<uint16_t>(I * sizeof(uint32_t)),
+        field_mask(I), nullptr, field_type(I), field_size(I))...}};
+  }
+
+  template <size_t... I>
+  static constexpr std::array<debug_core::LiveField, N> MakeLiveFields(
+      std::index_sequence<I...>) {
+    return {{debug_core::LiveField{NAMES.names[I], field_mask(I), nullptr,
+                                   field_type(I), &Read<I>, nullptr, -1,
+                                   field_size(I)}...}};
+  }
+
+  static void Capture(void* self, Snapshot* out) {
+    *out = static_cast<BenchModule*>(self)->snapshot_;
+  }
+
+  static bool ParseView(const char* arg, uint8_t* out_view) {
+    return debug_core::parse_view_name(arg, VIEW_TABLE, out_view);
+  }
+
+  static const char* ViewToString(uint8_t view) {
+    return debug_core::view_name(view, VIEW_TABLE);
+  }
+
+  static constexpr std::array<debug_core::FieldDesc, N> FIELDS =
+      MakeFields(std::make_index_sequence<N>{});
+  static constexpr std::array<debug_core::LiveField, N> LIVE_FIELDS =
+      MakeLiveFields(std::make_index_sequence<N>{});
+  static constexpr debug_core::StructuredProvider<Snapshot> PROVIDER{
+      "bench",      "state|ctrl", ParseView, ViewToString,
+      Capture,      FIELDS.data(), N};
+
+  Snapshot snapshot_{};
+};
+
+void bench_parse(CaptureSink& sink) {
+  auto parse_view = [](const char* arg, uint8_t* out_view) {
+    return debug_core::parse_view_name(arg, VIEW_TABLE, out_view);
+  };
+  auto print_once = [](uint8_t view, const debug_core::FrameContext&) {
+    g_sink = g_sink + view;
+  };
+  auto print_usage = [] {};
+
+  auto run = [&](const char* label, auto& args) {
+    report(label, 0, measure(sink, [&] {
+             debug_core::run_command(args.argc(), args.argv, VIEW_FULL,
+                                     parse_view, print_once, print_usage);
+           }));
+  };
+  Args once("bench", "once");
+  Args once_view("bench", "once", "ctrl");
+  Args direct_view("bench", "ctrl");
+  Args once_view_bin("bench", "once", "ctrl", "bin");
+  run("parse: once", once);
+  run("parse: once ctrl", once_view);
+  run("parse: ctrl", direct_view);
+  run("parse: once ctrl bin", once_view_bin);
+}
+
+template <size_t N>
+void bench_frames(CaptureSink& sink) {
+  static BenchModule<N> module;
+  Args once("bench", "once");
+  Args once_bin("bench", "once", "bin");
+
+  report("live: once", N,
+         measure(sink, [&] { module.Live(once.argc(), once.argv); }));
+  report("structured: once", N,
+         measure(sink, [&] { module.Structured(once.argc(), once.argv); }));
+  report("structured: once bin", N, measure(sink, [&] {
+           module.Structured(once_bin.argc(), once_bin.argv);
+         }));
+}
+
+}  // namespace
+
+int main() {
+  LibXR::PlatformInit();
+
+  std::fprintf(stderr, "%-28s %6s %10s %9s %12s %13s\n", "case", "fields",
+               "ns/frame", "ns/field", "bytes/frame", "allocs/frame");
+  CaptureSink sink;
+  bench_parse(sink);
+  bench_frames<4>(sink);
+  bench_frames<32>(sink);
+  bench_frames<128>(sink);
+  return 0;
+}
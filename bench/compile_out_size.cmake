@@ -0,0 +1,49 @@
+# 检查 DEBUG_CORE_ENABLED=0 的镜像中不含调试表，由 debug_core_bench_compile_out
+# 目标调用：
+# cmake -DNM=<nm> -DENABLED_BIN=<path> -DDISABLED_BIN=<path> -P compile_out_size.cmake
+#
+# 按符号统计 debug_core 命名空间的代码与数据，并按字符串统计探针模块的字段名、
+# 视图名与模块名（均以 size_probe_ 开头）。关闭时两者都必须为 0，否则构建失败。
+
+function(sum_symbols binary out_bytes out_count)
+  execute_process(COMMAND ${NM} -S -C -t d ${binary}
+                  OUTPUT_VARIABLE symbols RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "nm failed on ${binary}")
+  endif()
+  string(REPLACE "\n" ";" lines "${symbols}")
+  set(total 0)
+  set(count 0)
+  foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9]+ 0*([0-9]+) [a-zA-Z] (.*)$")
+      set(size "${CMAKE_MATCH_1}")
+      if(CMAKE_MATCH_2 MATCHES "debug_core::")
+        math(EXPR total "${total} + ${size}")
+        math(EXPR count "${count} + 1")
+      endif()
+    endif()
+  endforeach()
+  set(${out_bytes} ${total} PARENT_SCOPE)
+  set(${out_count} ${count} PARENT_SCOPE)
+endfunction()
+
+function(report label binary out_bytes out_strings)
+  sum_symbols(${binary} bytes count)
+  file(STRINGS ${binary} probe_strings REGEX "size_probe_")
+  list(LENGTH probe_strings strings)
+  file(SIZE ${binary} file_size)
+  message(STATUS "${label}: ${bytes} bytes in ${count} debug_core symbols, "
+                 "${strings} probe strings, image ${file_size} bytes")
+  set(${out_bytes} ${bytes} PARENT_SCOPE)
+  set(${out_strings} ${strings} PARENT_SCOPE)
+endfunction()
+
+report("DEBUG_CORE_ENABLED=1" ${ENABLED_BIN} enabled_bytes enabled_strings)
+report("DEBUG_CORE_ENABLED=0" ${DISABLED_BIN} disabled_bytes disabled_strings)
+
+if(enabled_bytes EQUAL 0 OR enabled_strings EQUAL 0)
+  message(FATAL_ERROR "enabled build carries no debug tables; probe is broken")
+endif()
+if(NOT disabled_bytes EQUAL 0 OR NOT disabled_strings EQUAL 0)
+  message(FATAL_ERROR "DEBUG_CORE_ENABLED=0 image still carries debug tables")
+endif()
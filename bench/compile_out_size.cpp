@@ -0,0 +1,161 @@
+// DEBUG_CORE_ENABLED 编译开关的体积验证：同一个接入了 Live 与 Structured 两种
+// 模式（含快照通道、飞行记录器、自定义打印、按视图字段索引、名称池、类型
+// 擦除的提供器入口）的模拟模块，分别以 DEBUG_CORE_ENABLED=1 / 0 构建。
+// debug_core_bench_compile_out 目标比较两者的符号与字符串，关闭时镜像中不应
+// 出现任何 debug_core 符号或字段名。
+//
+// 所有字段名、视图名与模块名都以 size_probe_ 开头，便于按字符串检查。
+
+#include <cstdint>
+
+#include "DebugCore.hpp"
+
+namespace {
+
+constexpr uint8_t VIEW_STATE = 0;
+constexpr uint8_t VIEW_CTRL = 1;
+constexpr uint8_t VIEW_FULL = 2;
+constexpr auto MASK_STATE = debug_core::view_bit(VIEW_STATE);
+constexpr auto MASK_CTRL = debug_core::view_bit(VIEW_CTRL);
+
+constexpr std::array<debug_core::ViewEntry<uint8_t>, 3> VIEW_TABLE{{
+    {"size_probe_state", VIEW_STATE},
+    {"size_probe_ctrl", VIEW_CTRL},
+    {"size_probe_full", VIEW_FULL},
+}};
+
+enum class Mode : uint8_t { IDLE, RUN, FAULT };
+
+struct DebugSnapshot {
+  Mode mode;
+  bool enabled;
+  uint8_t state;
+  int16_t current[4];
+  uint32_t ticks;
+  float target;
+  float output;
+  double integral;
+};
+
+constexpr debug_core::FieldDesc FIELDS[] = {
+    DEBUG_CORE_FIELD(DebugSnapshot, mode, MASK_STATE),
+    DEBUG_CORE_FIELD_BOOL(DebugSnapshot, enabled, MASK_STATE),
+    DEBUG_CORE_FIELD_U8(DebugSnapshot, state, MASK_STATE),
+    DEBUG_CORE_FIELD(DebugSnapshot, current, MASK_CTRL),
+    DEBUG_CORE_FIELD(DebugSnapshot, ticks, MASK_STATE),
+    DEBUG_CORE_FIELD_F32(DebugSnapshot, target, MASK_CTRL, 0.01f),
+    DEBUG_CORE_FIELD_PREC(DebugSnapshot, output, MASK_CTRL, 2, 0.0f,
+                          debug_core::Reduction::PEAK),
+    DEBUG_CORE_FIELD(DebugSnapshot, integral, MASK_CTRL),
+};
+
+constexpr auto FIELD_INDEX = debug_core::make_field_view_index<FIELDS>();
+constexpr auto NAMES = debug_core::make_name_pool<VIEW_TABLE, FIELDS>();
+
+bool parse_view(const char* arg, uint8_t* out_view) {
+  return debug_core::parse_view_name(arg, VIEW_TABLE, out_view);
+}
+
+const char* view_to_string(uint8_t view) {
+  return debug_core::view_name(view, VIEW_TABLE);
+}
+
+class SizeProbeModule {
+ public:
+  SizeProbeModule() {
+    debug_core::ProviderRegistry::Instance().Register(this, PROVIDER,
+                                                      VIEW_FULL);
+  }
+
+  void ControlLoop(uint32_t tick) {
+    ticks_ = tick;
+    output_ = target_ * 0.5f + static_cast<float>(tick % 7u);
+    auto& snap = channel_.Begin();
+    snap.mode = Mode::RUN;
+    snap.enabled = true;
+    snap.state = static_cast<uint8_t>(tick);
+    snap.ticks = ticks_;
+    snap.target = target_;
+    snap.output = output_;
+    snap.integral = static_cast<double>(output_) * 0.01;
+    channel_.Commit();
+    recorder_.Record(snap, tick);
+  }
+
+  int LiveCommand(int argc, char** argv) {
+    static const debug_core::LiveFieldDesc<SizeProbeModule> fields[] = {
+        DEBUG_CORE_LIVE_U8(SizeProbeModule, "size_probe_live_state",
+                           MASK_STATE, self->state_),
+        DEBUG_CORE_LIVE(SizeProbeModule, "size_probe_live_ticks", MASK_STATE,
+                        self->ticks_),
+        DEBUG_CORE_LIVE_F32(SizeProbeModule, "size_probe_live_target",
+                            MASK_CTRL, self->target_),
+        DEBUG_CORE_LIVE_PREC(SizeProbeModule, "size_probe_live_output",
+                             MASK_CTRL, self->output_, 3),
+        DEBUG_CORE_LIVE_CUSTOM(SizeProbeModule, "size_probe_live_pid",
+                               MASK_CTRL, print_pid),
+    };
+    // 经类型擦除的提供器入口，与模板外壳 run_live_command(this, ...) 等价
+    const debug_core::LiveField* erased = fields;
+    const debug_core::LiveProvider provider = debug_core::make_live_provider(
+        this, "size_probe_live", VIEW_TABLE, erased,
+        sizeof(fields) / sizeof(fields[0]), &SizeProbeModule::Lock,
+        &SizeProbeModule::Unlock, debug_core::FieldViewIndex{});
+    return debug_core::run_live_command(
+        provider, "size_probe_state|size_probe_ctrl", argc, argv, VIEW_FULL);
+  }
+
+  int StructuredCommand(int argc, char** argv) {
+    const debug_core::StructuredProviderBase& provider = PROVIDER;
+    return debug_core::run_structured_command(this, provider, argc, argv,
+                                              VIEW_FULL);
+  }
+
+ private:
+  static void Lock(SizeProbeModule* self) { self->locked_ = true; }
+
+  static void Unlock(SizeProbeModule* self) { self->locked_ = false; }
+
+  static void print_pid(debug_core::FrameWriter& out, const char* name,
+                        const SizeProbeModule* self) {
+    out.Printf<"  %s: kp=%.3f ki=%.3f\r\n">(
+        name, static_cast<double>(self->kp_), static_cast<double>(self->ki_));
+  }
+
+  static const debug_core::StructuredProvider<DebugSnapshot> PROVIDER;
+
+  uint8_t state_ = 1;
+  uint32_t ticks_ = 0;
+  float target_ = 2.5f;
+  float output_ = 0.0f;
+  float kp_ = 1.2f;
+  float ki_ = 0.05f;
+  bool locked_ = false;
+  debug_core::SnapshotChannel<DebugSnapshot> channel_;
+  debug_core::FlightRecorder<DebugSnapshot, 16> recorder_;
+};
+
+const debug_core::StructuredProvider<DebugSnapshot> SizeProbeModule::PROVIDER{
+    "size_probe_module",
+    "size_probe_state|size_probe_ctrl",
+    parse_view,
+    view_to_string,
+    debug_core::capture_from_channel<SizeProbeModule, DebugSnapshot,
+                                     &SizeProbeModule::channel_>,
+    FIELDS,
+    sizeof(FIELDS) / sizeof(FIELDS[0]),
+    [](void* self) -> debug_core::SnapshotRecorder<DebugSnapshot>* {
+      return &static_cast<SizeProbeModule*>(self)->recorder_;
+    },
+    FIELD_INDEX,
+    NAMES};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  static SizeProbeModule module;
+  for (uint32_t tick = 0; tick < 100; ++tick) {
+    module.ControlLoop(tick);
+  }
+  return module.LiveCommand(argc, argv) + module.StructuredCommand(argc, argv);
+}
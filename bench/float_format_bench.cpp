@@ -0,0 +1,90 @@
+// float 文本格式化微基准：snprintf("%.*f") 对比 format_f32()，同时逐值校验
+// 两者输出一致。仅依赖 DebugCoreFormat.hpp，在主机上构建运行：
+// cmake -DDEBUG_CORE_BUILD_BENCH=ON ...
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "DebugCoreFormat.hpp"
+
+namespace {
+
+constexpr size_t VALUE_COUNT = 4096;
+constexpr uint32_t ROUNDS = 500;
+
+// 防止编译器把格式化结果优化掉
+volatile uint32_t g_sink = 0;
+
+float g_values[VALUE_COUNT];
+
+template <typename Fn>
+double measure_ns(Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t round = 0; round < ROUNDS; ++round) {
+    for (size_t i = 0; i < VALUE_COUNT; ++i) {
+      fn(g_values[i]);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         (static_cast<double>(ROUNDS) * VALUE_COUNT);
+}
+
+size_t verify(uint8_t precision) {
+  size_t mismatches = 0;
+  for (float value : g_values) {
+    char expected[64];
+    char actual[debug_core::F32_TEXT_MAX];
+    int expected_len = std::snprintf(expected, sizeof(expected), "%.*f",
+                                     static_cast<int>(precision),
+                                     static_cast<double>(value));
+    size_t actual_len = debug_core::format_f32(actual, value, precision);
+    if (static_cast<size_t>(expected_len) != actual_len ||
+        std::memcmp(expected, actual, actual_len) != 0) {
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+}  // namespace
+
+int main() {
+  // 典型遥测量级：大部分落在 ±1000 内，混入少量极值与特殊值
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<float> typical(-1000.0f, 1000.0f);
+  std::uniform_int_distribution<uint32_t> bits;
+  for (size_t i = 0; i < VALUE_COUNT; ++i) {
+    if (i % 64 == 0) {
+      uint32_t raw = bits(rng);
+      std::memcpy(&g_values[i], &raw, sizeof(raw));
+    } else {
+      g_values[i] = typical(rng);
+    }
+  }
+
+  std::printf("values=%zu rounds=%u\n", VALUE_COUNT,
+              static_cast<unsigned>(ROUNDS));
+  for (uint8_t precision : {0, 2, 4, 6}) {
+    double printf_ns = measure_ns([&](float value) {
+      char text[64];
+      int len = std::snprintf(text, sizeof(text), "%.*f",
+                              static_cast<int>(precision),
+                              static_cast<double>(value));
+      g_sink = g_sink + static_cast<uint32_t>(len) + text[0];
+    });
+    double kernel_ns = measure_ns([&](float value) {
+      char text[debug_core::F32_TEXT_MAX];
+      size_t len = debug_core::format_f32(text, value, precision);
+      g_sink = g_sink + static_cast<uint32_t>(len) + text[0];
+    });
+    std::printf("precision=%u printf=%7.2f ns  format_f32=%7.2f ns  "
+                "speedup=%5.2fx  mismatch=%zu\n",
+                static_cast<unsigned>(precision), printf_ns, kernel_ns,
+                printf_ns / kernel_ns, verify(precision));
+  }
+  return 0;
+}
@@ -0,0 +1,31 @@
+# 汇总 float 格式化相关符号的代码体积，由 debug_core_bench_float_size 目标调用：
+# cmake -DNM=<nm> -DPRINTF_BIN=<path> -DKERNEL_BIN=<path> -P float_format_size.cmake
+#
+# 静态链接的 glibc 无论如何都会带入 vfprintf，整个 text 段之差反映不出浮点
+# 路径的开销，因此按符号统计：printf 侧为 __printf_fp* 与其依赖的 __mpn_*
+# 大数运算，format_f32 侧为 debug_core 中的格式化函数。
+
+function(sum_symbols binary pattern out_var)
+  execute_process(COMMAND ${NM} -S -C -t d ${binary}
+                  OUTPUT_VARIABLE symbols RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "nm failed on ${binary}")
+  endif()
+  string(REPLACE "\n" ";" lines "${symbols}")
+  set(total 0)
+  foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9]+ 0*([0-9]+) [tTwW] (.*)$")
+      set(size "${CMAKE_MATCH_1}")
+      set(name "${CMAKE_MATCH_2}")
+      if(name MATCHES "${pattern}")
+        math(EXPR total "${total} + ${size}")
+      endif()
+    endif()
+  endforeach()
+  set(${out_var} ${total} PARENT_SCOPE)
+endfunction()
+
+sum_symbols(${PRINTF_BIN} "^__printf_fp|^__mpn_" printf_bytes)
+sum_symbols(${KERNEL_BIN} "debug_core::.*format_" kernel_bytes)
+message(STATUS "printf float path (__printf_fp*, __mpn_*): ${printf_bytes} bytes")
+message(STATUS "format_f32 (+ helpers): ${kernel_bytes} bytes")
@@ -0,0 +1,28 @@
+// float 文本格式化代码体积对比：同一程序分别用 snprintf("%.4f") 与
+// format_f32() 格式化，DEBUG_CORE_SIZE_USE_PRINTF 选择路径。两者都只用
+// write 输出，静态链接后 text 段之差即 printf 浮点路径带入的代码量。
+// 构建 debug_core_bench_float_size 目标时打印 size 结果。
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "DebugCoreFormat.hpp"
+
+#ifndef DEBUG_CORE_SIZE_USE_PRINTF
+#define DEBUG_CORE_SIZE_USE_PRINTF 0
+#endif
+
+int main(int argc, char**) {
+  volatile float value = 3.14159f * static_cast<float>(argc);
+  char text[64];
+#if DEBUG_CORE_SIZE_USE_PRINTF
+  int len = std::snprintf(text, sizeof(text), "%.4f",
+                          static_cast<double>(value));
+#else
+  int len = static_cast<int>(debug_core::format_f32(text, value, 4));
+#endif
+  text[len++] = '\n';
+  return write(1, text, static_cast<size_t>(len)) == len ? 0 : 1;
+}
@@ -0,0 +1,437 @@
+// 控制环干扰基准：1 kHz 控制线程按绝对时刻周期运行，主线程以不同模式与速率
+// 对同一模块执行 monitor，统计控制线程的周期抖动、单次执行时间和加锁等待。
+// 链接 libxr（Linux 平台）在主机上构建运行：
+// cmake -DDEBUG_CORE_BUILD_BENCH=ON ...
+// ./debug_core_bench_interference [每种情形的时长 ms，默认 1000] > /dev/null
+//
+// 控制线程尽量以 SCHED_FIFO 运行（需要相应权限，失败时退回普通调度并在输出中
+// 注明），monitor 在普通优先级的主线程上同步运行。monitor 输出重定向到临时
+// 文件，结果写到 stderr。
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DebugCore.hpp"
+#include "capture_sink.hpp"
+#include "libxr.hpp"
+
+namespace {
+
+constexpr uint8_t VIEW_STATE = 0;
+constexpr uint8_t VIEW_CTRL = 1;
+constexpr uint8_t VIEW_FULL = 2;
+constexpr auto MASK_STATE = debug_core::view_bit(VIEW_STATE);
+constexpr auto MASK_CTRL = debug_core::view_bit(VIEW_CTRL);
+
+constexpr std::array<debug_core::ViewEntry<uint8_t>, 3> VIEW_TABLE{{
+    {"state", VIEW_STATE},
+    {"ctrl", VIEW_CTRL},
+    {"full", VIEW_FULL},
+}};
+
+constexpr int64_t PERIOD_NS = 1000000;  ///< 控制周期 1 ms
+constexpr int CONTROL_PRIORITY = 80;   ///< SCHED_FIFO 优先级
+constexpr size_t AXES = 8;
+
+/// 抖动直方图桶上界（us），最后一桶收纳其余
+constexpr std::array<int64_t, 8> JITTER_BUCKETS_US = {5,   10,  20,  50,
+                                                      100, 200, 500, 1000};
+/// 执行时间直方图桶上界（us）
+constexpr std::array<int64_t, 8> EXEC_BUCKETS_US = {20,  50,  100, 150,
+                                                    200, 300, 500, 1000};
+
+int64_t now_ns() {
+  timespec ts{};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+struct ControlSnapshot {
+  uint32_t tick;
+  uint8_t mode;
+  float error;
+  float target[AXES];
+  float output[AXES];
+};
+
+/**
+ * @brief 模拟控制模块：状态同时经 Live 字段表、快照通道对外提供
+ */
+class ControlModule {
+ public:
+  /**
+   * @brief 一个控制周期：计算放在锁外，结果在（可选的）锁内写回共享状态
+   * @return int64_t 加锁等待时间（ns），不加锁时为 0
+   */
+  int64_t Step(uint32_t tick, bool locked) {
+    float target[AXES];
+    float output[AXES];
+    float error = 0.0f;
+    for (size_t i = 0; i < AXES; ++i) {
+      target[i] = std::sin(static_cast<float>(tick) * 0.001f +
+                           static_cast<float>(i));
+      output[i] = work_[i];
+    }
+    // 固定的计算负载，约相当于一次多轴 PID + 滤波
+    for (int k = 0; k < 400; ++k) {
+      for (size_t i = 0; i < AXES; ++i) {
+        float e = target[i] - output[i];
+        output[i] += 0.002f * e + 0.0001f * std::tanh(e);
+      }
+    }
+    for (size_t i = 0; i < AXES; ++i) {
+      work_[i] = output[i];
+      error += std::fabs(target[i] - output[i]);
+    }
+
+    int64_t wait_ns = 0;
+    if (locked) {
+      int64_t before = now_ns();
+      mutex_.lock();
+      wait_ns = now_ns() - before;
+    }
+    state_.tick = tick;
+    state_.mode = static_cast<uint8_t>(tick / 1000 % 3);
+    state_.error = error;
+    std::copy(target, target + AXES, state_.target);
+    std::copy(output, output + AXES, state_.output);
+    if (locked) {
+      mutex_.unlock();
+    }
+
+    channel_.Publish(state_);
+    return wait_ns;
+  }
+
+  int Live(int argc, char** argv, bool locked) {
+    return debug_core::run_live_command(
+        this, "ctrl", "state|ctrl", VIEW_TABLE, LIVE_FIELDS, LIVE_FIELD_COUNT,
+        argc, argv, VIEW_FULL, locked ? Lock : nullptr,
+        locked ? Unlock : nullptr);
+  }
+
+  int Structured(int argc, char** argv) {
+    return debug_core::run_structured_command(this, PROVIDER, argc, argv,
+                                              VIEW_FULL);
+  }
+
+ private:
+  static void Lock(ControlModule* self) { self->mutex_.lock(); }
+
+  static void Unlock(ControlModule* self) { self->mutex_.unlock(); }
+
+  static bool ParseView(const char* arg, uint8_t* out_view) {
+    return debug_core::parse_view_name(arg, VIEW_TABLE, out_view);
+  }
+
+  static const char* ViewToString(uint8_t view) {
+    return debug_core::view_name(view, VIEW_TABLE);
+  }
+
+  static constexpr size_t LIVE_FIELD_COUNT = 5;
+  static const debug_core::LiveFieldDesc<ControlModule>
+      LIVE_FIELDS[LIVE_FIELD_COUNT];
+  static constexpr debug_core::FieldDesc FIELDS[] = {
+      DEBUG_CORE_FIELD(ControlSnapshot, tick, MASK_STATE),
+      DEBUG_CORE_FIELD(ControlSnapshot, mode, MASK_STATE),
+      DEBUG_CORE_FIELD(ControlSnapshot, error, MASK_CTRL),
+      DEBUG_CORE_FIELD(ControlSnapshot, target, MASK_CTRL),
+      DEBUG_CORE_FIELD(ControlSnapshot, output, MASK_CTRL),
+  };
+  static const debug_core::StructuredProvider<ControlSnapshot> PROVIDER;
+
+  std::mutex mutex_;
+  ControlSnapshot state_{};
+  float work_[AXES] = {};
+  debug_core::SnapshotChannel<ControlSnapshot> channel_;
+};
+
+const debug_core::LiveFieldDesc<ControlModule>
+    ControlModule::LIVE_FIELDS[LIVE_FIELD_COUNT] = {
+    DEBUG_CORE_LIVE(ControlModule, "tick", MASK_STATE, self->state_.tick),
+    DEBUG_CORE_LIVE(ControlModule, "mode", MASK_STATE, self->state_.mode),
+    DEBUG_CORE_LIVE(ControlModule, "error", MASK_CTRL, self->state_.error),
+    DEBUG_CORE_LIVE(ControlModule, "target", MASK_CTRL, self->state_.target),
+    DEBUG_CORE_LIVE(ControlModule, "output", MASK_CTRL, self->state_.output),
+};
+
+const debug_core::StructuredProvider<ControlSnapshot> ControlModule::PROVIDER{
+    "ctrl",
+    "state|ctrl",
+    ParseView,
+    ViewToString,
+    debug_core::capture_from_channel<ControlModule, ControlSnapshot,
+                                     &ControlModule::channel_>,
+    FIELDS,
+    sizeof(FIELDS) / sizeof(FIELDS[0])};
+
+/**
+ * @brief 控制线程的逐周期记录，存储在启动前一次分配好
+ */
+struct LoopSamples {
+  std::vector<int64_t> period_ns;
+  std::vector<int64_t> exec_ns;
+  std::vector<int64_t> lock_wait_ns;
+  uint32_t overruns = 0;  ///< 唤醒时已错过下一个周期的次数
+};
+
+/**
+ * @brief 1 kHz 控制线程，按绝对时刻唤醒
+ */
+class ControlLoop {
+ public:
+  ControlLoop(ControlModule& module, bool locked, size_t max_samples)
+      : module_(module), locked_(locked) {
+    samples_.period_ns.reserve(max_samples);
+    samples_.exec_ns.reserve(max_samples);
+    samples_.lock_wait_ns.reserve(max_samples);
+    max_samples_ = max_samples;
+  }
+
+  void Start() {
+    thread_ = std::thread([this] { Run(); });
+    sched_param param{};
+    param.sched_priority = CONTROL_PRIORITY;
+    realtime_ = pthread_setschedparam(thread_.native_handle(), SCHED_FIFO,
+                                      &param) == 0;
+    started_.store(true);
+  }
+
+  LoopSamples& Stop() {
+    stop_.store(true);
+    thread_.join();
+    return samples_;
+  }
+
+  bool Realtime() const { return realtime_; }
+
+ private:
+  void Run() {
+    while (!started_.load()) {
+      std::this_thread::yield();
+    }
+    timespec next{};
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    int64_t prev_start = 0;
+    uint32_t tick = 0;
+    while (!stop_.load(std::memory_order_relaxed) &&
+           samples_.exec_ns.size() < max_samples_) {
+      next.tv_nsec += PERIOD_NS;
+      if (next.tv_nsec >= 1000000000) {
+        next.tv_nsec -= 1000000000;
+        ++next.tv_sec;
+      }
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+
+      int64_t start = now_ns();
+      int64_t wait = module_.Step(tick++, locked_);
+      int64_t end = now_ns();
+
+      if (prev_start != 0) {
+        samples_.period_ns.push_back(start - prev_start);
+      }
+      samples_.exec_ns.push_back(end - start);
+      samples_.lock_wait_ns.push_back(wait);
+      prev_start = start;
+
+      // 错过的周期不补跑，从当前时刻重新对齐
+      int64_t deadline = static_cast<int64_t>(next.tv_sec) * 1000000000 +
+                         next.tv_nsec + PERIOD_NS;
+      if (end > deadline) {
+        ++samples_.overruns;
+        clock_gettime(CLOCK_MONOTONIC, &next);
+      }
+    }
+  }
+
+  ControlModule& module_;
+  bool locked_;
+  size_t max_samples_ = 0;
+  LoopSamples samples_;
+  std::thread thread_;
+  std::atomic<bool> started_{false};
+  std::atomic<bool> stop_{false};
+  bool realtime_ = false;
+};
+
+int64_t percentile(std::vector<int64_t>& values, double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  size_t k = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + k, values.end());
+  return values[k];
+}
+
+int64_t max_of(const std::vector<int64_t>& values) {
+  return values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+}
+
+template <size_t N>
+void print_histogram(const char* label, const std::vector<int64_t>& values_ns,
+                     const std::array<int64_t, N>& bounds_us) {
+  std::array<size_t, N + 1> counts{};
+  for (int64_t v : values_ns) {
+    int64_t us = v / 1000;
+    size_t bucket = 0;
+    while (bucket < N && us >= bounds_us[bucket]) {
+      ++bucket;
+    }
+    ++counts[bucket];
+  }
+  std::fprintf(stderr, "  %-10s", label);
+  for (size_t i = 0; i < N; ++i) {
+    std::fprintf(stderr, " <%lld:%zu", static_cast<long long>(bounds_us[i]),
+                 counts[i]);
+  }
+  std::fprintf(stderr, " >=%lld:%zu\n",
+               static_cast<long long>(bounds_us[N - 1]), counts[N]);
+}
+
+enum class Mode { IDLE, LIVE, LIVE_LOCKED, STRUCTURED, STRUCTURED_BIN };
+
+struct Scenario {
+  const char* label;
+  Mode mode;
+  int interval_ms;
+};
+
+void run_scenario(const Scenario& scenario, int duration_ms,
+                  debug_core_bench::CaptureSink& sink) {
+  static ControlModule module;
+  const bool locked = scenario.mode == Mode::LIVE_LOCKED;
+  ControlLoop loop(module, locked, static_cast<size_t>(duration_ms) * 2 + 64);
+
+  char time_arg[16];
+  char interval_arg[16];
+  char monitor_arg[] = "monitor";
+  char bin_arg[] = "bin";
+  char name_arg[] = "ctrl";
+  std::snprintf(time_arg, sizeof(time_arg), "%d", duration_ms);
+  std::snprintf(interval_arg, sizeof(interval_arg), "%d", scenario.interval_ms);
+  char* argv[] = {name_arg, monitor_arg, time_arg, interval_arg, bin_arg};
+
+  sink.Reset();
+  loop.Start();
+  int64_t start = now_ns();
+  switch (scenario.mode) {
+    case Mode::IDLE:
+      std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+      break;
+    case Mode::LIVE:
+    case Mode::LIVE_LOCKED:
+      module.Live(4, argv, locked);
+      break;
+    case Mode::STRUCTURED:
+      module.Structured(4, argv);
+      break;
+    case Mode::STRUCTURED_BIN:
+      module.Structured(5, argv);
+      break;
+  }
+  // monitor 在最后一帧之后立即返回，不会等满最后一个周期；控制环按固定的
+  // duration_ms 运行，各行统计覆盖相同长度的窗口
+  int64_t remain_ns =
+      start + static_cast<int64_t>(duration_ms) * 1000000 - now_ns();
+  if (remain_ns > 0) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(remain_ns));
+  }
+  double seconds = static_cast<double>(now_ns() - start) / 1e9;
+  LoopSamples& s = loop.Stop();
+  size_t bytes = sink.Bytes();
+
+  // 抖动：实际周期与 1 ms 的偏差绝对值
+  std::vector<int64_t> jitter;
+  jitter.reserve(s.period_ns.size());
+  for (int64_t p : s.period_ns) {
+    jitter.push_back(p > PERIOD_NS ? p - PERIOD_NS : PERIOD_NS - p);
+  }
+  std::vector<int64_t> exec = s.exec_ns;
+  std::vector<int64_t> wait = s.lock_wait_ns;
+
+  char interval[16] = "-";
+  if (scenario.mode != Mode::IDLE) {
+    std::snprintf(interval, sizeof(interval), "%d", scenario.interval_ms);
+  }
+  std::fprintf(stderr,
+               "%-16s %8s %7zu %8lld %8lld %8lld %8lld %8lld %8lld %8lld %8lld "
+               "%6u %10.0f\n",
+               scenario.label, interval, s.exec_ns.size(),
+               static_cast<long long>(percentile(jitter, 0.5) / 1000),
+               static_cast<long long>(percentile(jitter, 0.99) / 1000),
+               static_cast<long long>(max_of(jitter) / 1000),
+               static_cast<long long>(percentile(exec, 0.5) / 1000),
+               static_cast<long long>(percentile(exec, 0.99) / 1000),
+               static_cast<long long>(max_of(exec) / 1000),
+               static_cast<long long>(percentile(wait, 0.99) / 1000),
+               static_cast<long long>(max_of(wait) / 1000), s.overruns,
+               static_cast<double>(bytes) / seconds);
+  print_histogram("jitter_us", jitter, JITTER_BUCKETS_US);
+  print_histogram("exec_us", s.exec_ns, EXEC_BUCKETS_US);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  LibXR::PlatformInit();
+
+  int duration_ms = argc > 1 ? std::atoi(argv[1]) : 1000;
+  if (duration_ms <= 0) {
+    std::fprintf(stderr, "usage: %s [duration_ms]\n", argv[0]);
+    return 1;
+  }
+
+  static constexpr Scenario SCENARIOS[] = {
+      {"idle", Mode::IDLE, 0},
+      {"live", Mode::LIVE, 100},
+      {"live", Mode::LIVE, 10},
+      {"live", Mode::LIVE, 1},
+      {"live+lock", Mode::LIVE_LOCKED, 100},
+      {"live+lock", Mode::LIVE_LOCKED, 10},
+      {"live+lock", Mode::LIVE_LOCKED, 1},
+      {"structured", Mode::STRUCTURED, 100},
+      {"structured", Mode::STRUCTURED, 10},
+      {"structured", Mode::STRUCTURED, 1},
+      {"structured bin", Mode::STRUCTURED_BIN, 100},
+      {"structured bin", Mode::STRUCTURED_BIN, 10},
+      {"structured bin", Mode::STRUCTURED_BIN, 1},
+  };
+
+  {
+    // 仅用于探测调度策略，不计入结果
+    ControlModule probe_module;
+    ControlLoop probe(probe_module, false, 1);
+    probe.Start();
+    probe.Stop();
+    std::fprintf(stderr, "control loop: 1 kHz, %s, %d ms per scenario\n",
+                 probe.Realtime() ? "SCHED_FIFO"
+                                  : "SCHED_OTHER (no RT permission)",
+                 duration_ms);
+  }
+  std::fprintf(stderr,
+               "%-16s %8s %7s %8s %8s %8s %8s %8s %8s %8s %8s %6s %10s\n",
+               "mode", "interval", "cycles", "jit_p50", "jit_p99", "jit_max",
+               "exe_p50", "exe_p99", "exe_max", "lock_p99", "lock_max",
+               "overrun", "out_B/s");
+  std::fprintf(stderr, "%-16s %8s %7s %8s %8s %8s %8s %8s %8s %8s %8s\n", "",
+               "(ms)", "", "(us)", "(us)", "(us)", "(us)", "(us)", "(us)",
+               "(us)", "(us)");
+
+  debug_core_bench::CaptureSink sink;
+  for (const auto& scenario : SCENARIOS) {
+    run_scenario(scenario, duration_ms, sink);
+  }
+  return 0;
+}
@@ -0,0 +1,51 @@
+# 统计每接入一个模块的代码体积，由 debug_core_bench_module_cost 目标调用：
+# cmake -DNM=<nm> -DSMALL_BIN=<path> -DSMALL_MODULES=<n> -DLARGE_BIN=<path>
+#       -DLARGE_MODULES=<m> -P module_cost.cmake
+#
+# 两个镜像只差模拟模块的数量，按 nm 符号类型分别累计代码（t/T/W/w）、只读数据
+# （r/R）与可写数据（d/D/V/v/u），两者之差除以模块数之差即每个模块的增量。
+
+function(sum_sections binary out_text out_rodata out_data)
+  execute_process(COMMAND ${NM} -S -t d ${binary}
+                  OUTPUT_VARIABLE symbols RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "nm failed on ${binary}")
+  endif()
+  string(REPLACE "\n" ";" lines "${symbols}")
+  set(text 0)
+  set(rodata 0)
+  set(data 0)
+  foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9]+ 0*([0-9]+) ([a-zA-Z]) ")
+      set(size "${CMAKE_MATCH_1}")
+      set(type "${CMAKE_MATCH_2}")
+      if(type MATCHES "^[tTWw]$")
+        math(EXPR text "${text} + ${size}")
+      elseif(type MATCHES "^[rR]$")
+        math(EXPR rodata "${rodata} + ${size}")
+      elseif(type MATCHES "^[dDVvu]$")
+        math(EXPR data "${data} + ${size}")
+      endif()
+    endif()
+  endforeach()
+  set(${out_text} ${text} PARENT_SCOPE)
+  set(${out_rodata} ${rodata} PARENT_SCOPE)
+  set(${out_data} ${data} PARENT_SCOPE)
+endfunction()
+
+sum_sections(${SMALL_BIN} small_text small_rodata small_data)
+sum_sections(${LARGE_BIN} large_text large_rodata large_data)
+message(STATUS "${SMALL_MODULES} module(s): text ${small_text}, "
+               "rodata ${small_rodata}, data ${small_data}")
+message(STATUS "${LARGE_MODULES} module(s): text ${large_text}, "
+               "rodata ${large_rodata}, data ${large_data}")
+
+math(EXPR modules "${LARGE_MODULES} - ${SMALL_MODULES}")
+if(modules LESS_EQUAL 0)
+  message(FATAL_ERROR "LARGE_MODULES must exceed SMALL_MODULES")
+endif()
+math(EXPR per_text "(${large_text} - ${small_text}) / ${modules}")
+math(EXPR per_rodata "(${large_rodata} - ${small_rodata}) / ${modules}")
+math(EXPR per_data "(${large_data} - ${small_data}) / ${modules}")
+message(STATUS "per module: text ${per_text}, rodata ${per_rodata}, "
+               "data ${per_data}")
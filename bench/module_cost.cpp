@@ -0,0 +1,129 @@
+// 每接入一个模块的代码体积：DEBUG_CORE_BENCH_MODULES 个互不相同的模拟模块
+// （各自的模块类型、快照类型与视图表），每个都同时接入 Live 与 Structured
+// 两种命令、快照通道和飞行记录器。debug_core_bench_module_cost 目标分别以
+// 1 个和 12 个模块构建，两者之差除以 11 即每个模块新增的代码与只读数据。
+
+#include <cstdint>
+#include <utility>
+
+#include "DebugCore.hpp"
+
+#ifndef DEBUG_CORE_BENCH_MODULES
+#define DEBUG_CORE_BENCH_MODULES 12
+#endif
+
+namespace {
+
+constexpr uint8_t VIEW_STATE = 0;
+constexpr uint8_t VIEW_CTRL = 1;
+constexpr uint8_t VIEW_FULL = 2;
+constexpr auto MASK_STATE = debug_core::view_bit(VIEW_STATE);
+constexpr auto MASK_CTRL = debug_core::view_bit(VIEW_CTRL);
+
+template <int K>
+struct DebugSnapshot {
+  uint8_t state;
+  bool enabled;
+  int16_t current[2];
+  float target;
+  float output;
+  uint8_t reserved[K + 1];  // 每个模块的快照类型与大小都不同
+};
+
+template <int K>
+class Module {
+ public:
+  using Snapshot = DebugSnapshot<K>;
+
+  static constexpr std::array<debug_core::ViewEntry<uint8_t>, 3> VIEW_TABLE{{
+      {"state", VIEW_STATE},
+      {"ctrl", VIEW_CTRL},
+      {"full", VIEW_FULL},
+  }};
+
+  static constexpr debug_core::FieldDesc FIELDS[] = {
+      DEBUG_CORE_FIELD_U8(Snapshot, state, MASK_STATE),
+      DEBUG_CORE_FIELD_BOOL(Snapshot, enabled, MASK_STATE),
+      DEBUG_CORE_FIELD(Snapshot, current, MASK_CTRL),
+      DEBUG_CORE_FIELD_F32(Snapshot, target, MASK_CTRL),
+      DEBUG_CORE_FIELD_F32(Snapshot, output, MASK_CTRL),
+  };
+
+  void ControlLoop(uint32_t tick) {
+    output_ = target_ * 0.5f + static_cast<float>(tick % 7u);
+    auto& snap = channel_.Begin();
+    snap.state = state_;
+    snap.enabled = true;
+    snap.target = target_;
+    snap.output = output_;
+    channel_.Commit();
+    recorder_.Record(snap, tick);
+  }
+
+  int LiveCommand(int argc, char** argv) {
+    static const debug_core::LiveFieldDesc<Module> fields[] = {
+        DEBUG_CORE_LIVE_U8(Module, "state", MASK_STATE, self->state_),
+        DEBUG_CORE_LIVE_F32(Module, "target", MASK_CTRL, self->target_),
+        DEBUG_CORE_LIVE_F32(Module, "output", MASK_CTRL, self->output_),
+    };
+    return debug_core::run_live_command(
+        this, "live", "state|ctrl", VIEW_TABLE, fields,
+        sizeof(fields) / sizeof(fields[0]), argc, argv, VIEW_FULL);
+  }
+
+  int StructuredCommand(int argc, char** argv) {
+    return debug_core::run_structured_command(this, PROVIDER, argc, argv,
+                                              VIEW_FULL);
+  }
+
+ private:
+  static bool ParseView(const char* arg, uint8_t* out_view) {
+    return debug_core::parse_view_name(arg, VIEW_TABLE, out_view);
+  }
+
+  static const char* ViewToString(uint8_t view) {
+    return debug_core::view_name(view, VIEW_TABLE);
+  }
+
+  static debug_core::SnapshotRecorder<Snapshot>* Recorder(void* self) {
+    return &static_cast<Module*>(self)->recorder_;
+  }
+
+  static const debug_core::StructuredProvider<Snapshot> PROVIDER;
+
+  uint8_t state_ = K;
+  float target_ = 2.5f;
+  float output_ = 0.0f;
+  debug_core::SnapshotChannel<Snapshot> channel_;
+  debug_core::FlightRecorder<Snapshot, 8> recorder_;
+};
+
+template <int K>
+const debug_core::StructuredProvider<DebugSnapshot<K>> Module<K>::PROVIDER{
+    "structured",
+    "state|ctrl",
+    ParseView,
+    ViewToString,
+    debug_core::capture_from_channel<Module, Snapshot, &Module::channel_>,
+    FIELDS,
+    sizeof(FIELDS) / sizeof(FIELDS[0]),
+    Recorder};
+
+template <int K>
+int run_module(int argc, char** argv) {
+  static Module<K> module;
+  module.ControlLoop(static_cast<uint32_t>(argc));
+  return module.LiveCommand(argc, argv) + module.StructuredCommand(argc, argv);
+}
+
+template <int... K>
+int run_modules(int argc, char** argv, std::integer_sequence<int, K...>) {
+  return (run_module<K>(argc, argv) + ...);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  return run_modules(
+      argc, argv, std::make_integer_sequence<int, DEBUG_CORE_BENCH_MODULES>{});
+}
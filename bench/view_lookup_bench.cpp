@@ -0,0 +1,76 @@
+// 视图查找微基准：线性查找（parse_view_name / view_name 的 std::array 重载）
+// 对比 make_view_lookup() 生成的完美哈希表。仅依赖 DebugCoreView.hpp，在主机上
+// 构建运行：cmake -DDEBUG_CORE_BUILD_BENCH=ON ...
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "DebugCoreView.hpp"
+
+namespace {
+
+using debug_core::ViewEntry;
+
+constexpr std::array<ViewEntry<uint8_t>, 20> VIEW_TABLE{{
+    {"state", 0},   {"pid", 1},     {"heat", 2},    {"motor", 3},
+    {"imu", 4},     {"ctrl", 5},    {"ref", 6},     {"fb", 7},
+    {"limit", 8},   {"fault", 9},   {"power", 10},  {"can", 11},
+    {"uart", 12},   {"timing", 13}, {"shoot", 14},  {"gimbal", 15},
+    {"chassis", 16}, {"cap", 17},   {"debug", 18},  {"full", 19},
+}};
+
+constexpr auto VIEW_LOOKUP = debug_core::make_view_lookup(VIEW_TABLE);
+
+constexpr uint32_t ITERATIONS = 2000000;
+
+// 防止编译器把查找结果优化掉
+volatile uint32_t g_sink = 0;
+
+template <typename Fn>
+double measure_ns(Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < ITERATIONS; ++i) {
+    fn(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         ITERATIONS;
+}
+
+template <typename Table>
+void run(const char* label, const Table& table) {
+  // 名称来自可写数组，避免编译器按字面量地址折叠比较
+  static char names[VIEW_TABLE.size()][16];
+  for (size_t i = 0; i < VIEW_TABLE.size(); ++i) {
+    std::snprintf(names[i], sizeof(names[i]), "%s", VIEW_TABLE[i].name);
+  }
+
+  double parse_ns = measure_ns([&](uint32_t i) {
+    uint8_t view = 0;
+    debug_core::parse_view_name(names[i % VIEW_TABLE.size()], table, &view);
+    g_sink = g_sink + view;
+  });
+  double miss_ns = measure_ns([&](uint32_t) {
+    uint8_t view = 0;
+    g_sink = g_sink + debug_core::parse_view_name("nope", table, &view);
+  });
+  double name_ns = measure_ns([&](uint32_t i) {
+    const char* name =
+        debug_core::view_name(static_cast<uint8_t>(i % VIEW_TABLE.size()), table);
+    g_sink = g_sink + static_cast<uint8_t>(name[0]);
+  });
+
+  std::printf("%-8s parse=%6.2f ns  parse_miss=%6.2f ns  view_name=%6.2f ns\n",
+              label, parse_ns, miss_ns, name_ns);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("views=%zu iterations=%u\n", VIEW_TABLE.size(),
+              static_cast<unsigned>(ITERATIONS));
+  run("linear", VIEW_TABLE);
+  run("phf", VIEW_LOOKUP);
+  return 0;
+}